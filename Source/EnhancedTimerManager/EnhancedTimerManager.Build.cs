@@ -26,6 +26,8 @@ public class EnhancedTimerManager : ModuleRules
 			new string[]
 			{
 				"Core",
+				"NetCore",
+				"GameplayTags",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,6 +38,9 @@ public class EnhancedTimerManager : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Chaos",
+				"PhysicsCore",
+				"RenderCore",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
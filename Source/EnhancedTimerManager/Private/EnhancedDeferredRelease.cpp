@@ -0,0 +1,92 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedDeferredRelease.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
+
+uint16 FEnhancedDeferredRelease::RegisterAction(FEnhancedDeferredReleaseDelegate&& Action)
+{
+	check(Actions.Num() < MAX_uint16);
+	Actions.Add(MoveTemp(Action));
+	return (uint16)Actions.Num();
+}
+
+void FEnhancedDeferredRelease::ReleaseAfter(UObject* Object, float Seconds, uint16 Action)
+{
+	if (!Object) return;
+
+	FEntry Entry;
+	Entry.Deadline = Time + FMath::Max(0.f, Seconds);
+	Entry.Object   = FObjectKey(Object);
+	Entry.Serial   = NextSerial++;
+	Entry.Action   = Action;
+
+	// A previous entry of the same object becomes stale.
+	Pending.Add(Entry.Object, { Entry.Deadline, Entry.Serial });
+	Heap.HeapPush(Entry);
+}
+
+bool FEnhancedDeferredRelease::Cancel(const UObject* Object)
+{
+	return Object && Pending.Remove(FObjectKey(Object)) > 0;
+}
+
+float FEnhancedDeferredRelease::GetTimeLeft(const UObject* Object) const
+{
+	const FPendingRelease* Found = Object ? Pending.Find(FObjectKey(Object)) : nullptr;
+	return Found ? (float)FMath::Max(0.0, Found->Deadline - Time) : -1.f;
+}
+
+void FEnhancedDeferredRelease::Reset()
+{
+	Heap.Reset();
+	Pending.Reset();
+}
+
+void FEnhancedDeferredRelease::RunAction(UObject* Object, uint16 Action)
+{
+	if (Action == DestroyAction)
+	{
+		if (AActor* Actor = Cast<AActor>(Object))
+		{
+			Actor->Destroy();
+		}
+		return;
+	}
+
+	if (Actions.IsValidIndex(Action - 1))
+	{
+		Actions[Action - 1].ExecuteIfBound(Object);
+	}
+}
+
+int32 FEnhancedDeferredRelease::Tick(float DeltaTime, const UWorld* World, bool bGamePaused, int32 MaxPerFrame)
+{
+	if (Heap.Num() == 0) return 0;
+
+	if (!bGamePaused)
+	{
+		Time += DeltaTime * (World ? UGameplayStatics::GetGlobalTimeDilation(World) : 1.f);
+	}
+
+	int32 NumRun = 0;
+	while (Heap.Num() > 0 && Heap.HeapTop().Deadline <= Time)
+	{
+		if (MaxPerFrame > 0 && NumRun >= MaxPerFrame) break;
+
+		FEntry Entry;
+		Heap.HeapPop(Entry, EAllowShrinking::No);
+
+		const FPendingRelease* Current = Pending.Find(Entry.Object);
+		if (!Current || Current->Serial != Entry.Serial) continue;   // cancelled or rescheduled
+		Pending.Remove(Entry.Object);
+
+		// Objects collected in the meantime have nothing left to release.
+		if (UObject* Object = Entry.Object.ResolveObjectPtr())
+		{
+			RunAction(Object, Entry.Action);
+			++NumRun;
+		}
+	}
+	return NumRun;
+}
@@ -0,0 +1,52 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedIntervalTicks.h"
+
+FEnhancedIntervalTickHandle FEnhancedIntervalTicks::Register(float Interval,
+                                                            FEnhancedIntervalTickDelegate&& Callback,
+                                                            EEnhancedTimerTimeDilationMode DilationMode,
+                                                            AActor* DilationActor,
+                                                            bool bAffectedByGamePause)
+{
+	FEnhancedBatchKey Key;
+	Key.SubKey                  = FMath::Max(0, FMath::RoundToInt(Interval * 1000.f));
+	Key.Domain.DilationMode     = DilationMode;
+	Key.Domain.Actor            = DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation ? DilationActor : nullptr;
+	Key.Domain.bTicksWhenPaused = bAffectedByGamePause;
+
+	FEntry Entry;
+	Entry.Callback = MoveTemp(Callback);
+	Entry.Interval = Key.SubKey / 1000.f;
+
+	FEnhancedIntervalTickHandle Handle;
+	Handle.Id = Entries.Add(Key, MoveTemp(Entry));
+	return Handle;
+}
+
+bool FEnhancedIntervalTicks::Unregister(const FEnhancedIntervalTickHandle& Handle)
+{
+	if (!Handle.IsValid()) return false;
+	return Entries.Remove(Handle.Id, [](FEntry& Entry) { Entry.Callback.Unbind(); });
+}
+
+int32 FEnhancedIntervalTicks::Tick(float DeltaTime, const UWorld* World, bool bGamePaused)
+{
+	int32 NumCalls = 0;
+	Entries.Tick(DeltaTime, World, bGamePaused, [&NumCalls](FEntry& Entry, double Now, double& NextDue)
+	{
+		const float Elapsed = (float)(Now - Entry.LastTime);
+		Entry.LastTime = Now;
+
+		// Keep the phase; after a long hitch run once instead of catching up.
+		NextDue += Entry.Interval;
+		if (NextDue <= Now)
+		{
+			NextDue = Now + Entry.Interval;
+		}
+
+		if (!Entry.Callback.ExecuteIfBound(Elapsed)) return false;
+		++NumCalls;
+		return true;
+	});
+	return NumCalls;
+}
@@ -0,0 +1,197 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedPhysicsTimerClock.h"
+#include "Engine/World.h"
+#include "Chaos/SimCallbackObject.h"
+#include "PBDRigidsSolver.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+
+namespace EnhancedPhysicsTimers
+{
+	// Process-wide so handles from a previous world never alias timers of a new clock.
+	static std::atomic<uint64> NextId{1};
+
+	/** Solver callback that owns the clock and advances it before every physics (sub)step. */
+	class FSimCallback : public Chaos::TSimCallbackObject<Chaos::FSimCallbackNoInput, Chaos::FSimCallbackNoOutput, Chaos::ESimCallbackOptions::Presimulate>
+	{
+	public:
+		FEnhancedPhysicsTimerClock Clock;
+
+		virtual void OnPreSimulate_Internal() override
+		{
+			Clock.Advance_Internal((float)GetDeltaTime_Internal());
+		}
+	};
+}
+
+FEnhancedPhysicsTimerClock* FEnhancedPhysicsTimerClock::RegisterWithWorld(UWorld* World)
+{
+	check(IsInGameThread());
+
+	FPhysScene* Scene = World ? World->GetPhysicsScene() : nullptr;
+	Chaos::FPhysicsSolver* Solver = Scene ? Scene->GetSolver() : nullptr;
+	if (!Solver) return nullptr;
+
+	EnhancedPhysicsTimers::FSimCallback* Callback = Solver->CreateAndRegisterSimCallbackObject_External<EnhancedPhysicsTimers::FSimCallback>();
+	Callback->Clock.SimCallback = Callback;
+	return &Callback->Clock;
+}
+
+void FEnhancedPhysicsTimerClock::UnregisterFromWorld(UWorld* World, FEnhancedPhysicsTimerClock* Clock)
+{
+	check(IsInGameThread());
+	if (!Clock || !Clock->SimCallback) return;
+
+	FPhysScene* Scene = World ? World->GetPhysicsScene() : nullptr;
+	if (Chaos::FPhysicsSolver* Solver = Scene ? Scene->GetSolver() : nullptr)
+	{
+		Solver->UnregisterAndFreeSimCallbackObject_External(Clock->SimCallback);
+	}
+}
+
+FEnhancedPhysicsTimerHandle FEnhancedPhysicsTimerClock::AllocateHandle()
+{
+	FEnhancedPhysicsTimerHandle Handle;
+	Handle.Id = EnhancedPhysicsTimers::NextId.fetch_add(1, std::memory_order_relaxed);
+	return Handle;
+}
+
+FEnhancedPhysicsTimerHandle FEnhancedPhysicsTimerClock::Add(float Duration, bool bLoop, FCallback&& Callback)
+{
+	const FEnhancedPhysicsTimerHandle Handle = AllocateHandle();
+	Add(Handle, Duration, bLoop, MoveTemp(Callback));
+	return Handle;
+}
+
+void FEnhancedPhysicsTimerClock::Add(const FEnhancedPhysicsTimerHandle& Handle, float Duration, bool bLoop, FCallback&& Callback)
+{
+	FCommand Cmd;
+	Cmd.Type     = FCommand::EType::Add;
+	Cmd.Id       = Handle.Id;
+	Cmd.Duration = FMath::Max(0.f, Duration);
+	Cmd.bLoop    = bLoop;
+	Cmd.Callback = MoveTemp(Callback);
+	Commands.Enqueue(MoveTemp(Cmd));
+}
+
+void FEnhancedPhysicsTimerClock::Cancel(const FEnhancedPhysicsTimerHandle& Handle)
+{
+	if (!Handle.IsValid()) return;
+
+	FCommand Cmd;
+	Cmd.Type = FCommand::EType::Cancel;
+	Cmd.Id   = Handle.Id;
+	Commands.Enqueue(MoveTemp(Cmd));
+}
+
+void FEnhancedPhysicsTimerClock::CancelAll()
+{
+	FCommand Cmd;
+	Cmd.Type = FCommand::EType::CancelAll;
+	Commands.Enqueue(MoveTemp(Cmd));
+}
+
+void FEnhancedPhysicsTimerClock::ProcessCommands_Internal()
+{
+	FCommand Cmd;
+	while (Commands.Dequeue(Cmd))
+	{
+		switch (Cmd.Type)
+		{
+			case FCommand::EType::Add:
+			{
+				FTimer& T  = Timers.AddDefaulted_GetRef();
+				T.Id       = Cmd.Id;
+				T.Deadline = Time + Cmd.Duration;
+				T.Duration = Cmd.Duration;
+				T.bLoop    = Cmd.bLoop;
+				T.Callback = MoveTemp(Cmd.Callback);
+				IdToIndex.Add(T.Id, Timers.Num() - 1);
+				break;
+			}
+			case FCommand::EType::Cancel:
+			{
+				if (const int32* Index = IdToIndex.Find(Cmd.Id))
+				{
+					RemoveAt_Internal(*Index);
+				}
+				break;
+			}
+			case FCommand::EType::CancelAll:
+			{
+				Timers.Reset();
+				IdToIndex.Reset();
+				break;
+			}
+		}
+	}
+}
+
+void FEnhancedPhysicsTimerClock::RemoveAt_Internal(int32 Index)
+{
+	IdToIndex.Remove(Timers[Index].Id);
+	Timers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Timers.IsValidIndex(Index))
+	{
+		IdToIndex.Add(Timers[Index].Id, Index);
+	}
+}
+
+void FEnhancedPhysicsTimerClock::Advance_Internal(float DeltaTime)
+{
+	ProcessCommands_Internal();
+
+	Time += FMath::Max(0.f, DeltaTime);
+
+	DueScratch.Reset();
+	for (int32 i = 0; i < Timers.Num(); ++i)
+	{
+		if (Timers[i].Deadline <= Time)
+		{
+			DueScratch.Add(i);
+		}
+	}
+
+	if (DueScratch.Num() > 0)
+	{
+		// Deterministic order: earliest deadline first, then creation order.
+		DueScratch.Sort([this](int32 A, int32 B)
+		{
+			const FTimer& TA = Timers[A];
+			const FTimer& TB = Timers[B];
+			return TA.Deadline != TB.Deadline ? TA.Deadline < TB.Deadline : TA.Id < TB.Id;
+		});
+
+		// Callbacks cannot touch Timers directly (only through the command queue), so indices stay valid.
+		for (int32 Index : DueScratch)
+		{
+			FTimer& T = Timers[Index];
+			if (T.Callback)
+			{
+				T.Callback(Time);
+			}
+		}
+
+		// Re-arm loops (drift-free, without catching up missed periods); remove one-shots back to front.
+		DueScratch.Sort(TGreater<int32>());
+		for (int32 Index : DueScratch)
+		{
+			FTimer& T = Timers[Index];
+			if (T.bLoop)
+			{
+				T.Deadline += T.Duration;
+				if (T.Deadline <= Time)
+				{
+					T.Deadline = Time + T.Duration;
+				}
+			}
+			else
+			{
+				RemoveAt_Internal(Index);
+			}
+		}
+	}
+
+	PublishedTime.store(Time, std::memory_order_release);
+	PublishedNumActive.store(Timers.Num(), std::memory_order_release);
+}
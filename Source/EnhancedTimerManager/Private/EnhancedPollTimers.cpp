@@ -0,0 +1,99 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedPollTimers.h"
+
+FEnhancedPollHandle FEnhancedPollTimers::Register(FEnhancedPollPredicate&& Predicate,
+                                                  FEnhancedPollFinishedDelegate&& OnFinished,
+                                                  const FEnhancedPollSettings& Settings,
+                                                  EEnhancedTimerTimeDilationMode DilationMode,
+                                                  AActor* DilationActor,
+                                                  bool bAffectedByGamePause)
+{
+	FEnhancedBatchKey Key;
+	Key.Domain.DilationMode     = DilationMode;
+	Key.Domain.Actor            = DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation ? DilationActor : nullptr;
+	Key.Domain.bTicksWhenPaused = bAffectedByGamePause;
+
+	FEntry Entry;
+	Entry.Predicate   = MoveTemp(Predicate);
+	Entry.OnFinished  = MoveTemp(OnFinished);
+	Entry.MinInterval = FMath::Max(0.f, Settings.MinInterval);
+	Entry.MaxInterval = FMath::Max(Entry.MinInterval, Settings.MaxInterval);
+	Entry.Interval    = FMath::Clamp(Settings.InitialInterval, 0.f, Entry.MaxInterval);
+	Entry.Backoff     = FMath::Max(1.f, Settings.Backoff);
+	Entry.Timeout     = Settings.Timeout;
+
+	FEnhancedPollHandle Handle;
+	Handle.Id = Polls.Add(Key, MoveTemp(Entry));
+	return Handle;
+}
+
+bool FEnhancedPollTimers::Unregister(const FEnhancedPollHandle& Handle)
+{
+	if (!Handle.IsValid()) return false;
+
+	bool bFound = Polls.Remove(Handle.Id, [](FEntry& Entry)
+	{
+		Entry.Predicate.Unbind();
+		Entry.OnFinished.Unbind();
+	});
+
+	// Finished this frame but its callback has not run yet: cancelling still suppresses it.
+	for (TArray<FFinished>* List : { &Finished, &FinishedToRun })
+	{
+		for (FFinished& Entry : *List)
+		{
+			if (Entry.Id == Handle.Id && Entry.OnFinished.IsBound())
+			{
+				Entry.OnFinished.Unbind();
+				bFound = true;
+			}
+		}
+	}
+	return bFound;
+}
+
+void FEnhancedPollTimers::Reset()
+{
+	Polls.Reset();
+	Finished.Reset();
+	FinishedToRun.Reset();
+}
+
+int32 FEnhancedPollTimers::Tick(float DeltaTime, const UWorld* World, bool bGamePaused)
+{
+	int32 NumPolls = 0;
+	Polls.Tick(DeltaTime, World, bGamePaused, [this, &NumPolls](FEntry& Entry, double Now, double& NextPoll)
+	{
+		if (!Entry.Predicate.IsBound()) return false;
+
+		const bool bSatisfied = Entry.Predicate.Execute();
+		++NumPolls;
+
+		if (bSatisfied || Now >= Entry.Deadline)
+		{
+			Finished.Add({ Entry.Id, MoveTemp(Entry.OnFinished), bSatisfied });
+			Entry.Predicate.Unbind();
+			return false;
+		}
+
+		// Wait the current interval (never past the timeout), then back off for the poll after it.
+		NextPoll = FMath::Min(Now + Entry.Interval, Entry.Deadline);
+		Entry.Interval = FMath::Clamp(Entry.Interval * Entry.Backoff, Entry.MinInterval, Entry.MaxInterval);
+		return true;
+	});
+
+	// Outside the scan: callbacks may start or cancel polls freely (a cancelled one is unbound in FinishedToRun).
+	if (Finished.Num() > 0)
+	{
+		Swap(Finished, FinishedToRun);
+		for (FFinished& Entry : FinishedToRun)
+		{
+			const FEnhancedPollFinishedDelegate OnFinished = MoveTemp(Entry.OnFinished);
+			OnFinished.ExecuteIfBound(Entry.bSatisfied);
+		}
+		FinishedToRun.Reset();
+	}
+
+	return NumPolls;
+}
@@ -0,0 +1,187 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedSchedulePlayback.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Algo/StableSort.h"
+
+UEnhancedSchedulePlayback* UEnhancedSchedulePlayback::CreateFromDataTable(UObject* WorldContextObject, UDataTable* Table,
+	EEnhancedTimerTimeDilationMode InDilationMode, AActor* InDilationActor, bool bInAffectedByGamePause, int32 InWindowSize)
+{
+	if (!Table || !Table->GetRowStruct() || !Table->GetRowStruct()->IsChildOf(FEnhancedScheduleEvent::StaticStruct()))
+	{
+		UE_LOG(LogEnhancedTimerManager, Warning, TEXT("Schedule playback needs a DataTable with FEnhancedScheduleEvent rows."));
+		return nullptr;
+	}
+
+	TArray<FEnhancedScheduleEvent> Events;
+	Events.Reserve(Table->GetRowMap().Num());
+	for (const TPair<FName, uint8*>& Row : Table->GetRowMap())
+	{
+		Events.Add(*reinterpret_cast<const FEnhancedScheduleEvent*>(Row.Value));
+	}
+	return CreateFromEvents(WorldContextObject, MoveTemp(Events), InDilationMode, InDilationActor, bInAffectedByGamePause, InWindowSize);
+}
+
+UEnhancedSchedulePlayback* UEnhancedSchedulePlayback::CreateFromCSV(UObject* WorldContextObject, const FString& CSV,
+	EEnhancedTimerTimeDilationMode InDilationMode, AActor* InDilationActor, bool bInAffectedByGamePause, int32 InWindowSize)
+{
+	TArray<FString> Lines;
+	CSV.ParseIntoArrayLines(Lines);
+
+	TArray<FEnhancedScheduleEvent> Events;
+	Events.Reserve(Lines.Num());
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Cells;
+		Lines[LineIndex].ParseIntoArray(Cells, TEXT(","), false);
+		for (FString& Cell : Cells)
+		{
+			Cell.TrimStartAndEndInline();
+		}
+		if (Cells.Num() == 0 || Cells[0].IsEmpty()) continue;
+
+		if (!Cells[0].IsNumeric())
+		{
+			if (LineIndex == 0) continue;   // header
+			UE_LOG(LogEnhancedTimerManager, Warning, TEXT("Schedule CSV line %d: '%s' is not a time."), LineIndex + 1, *Cells[0]);
+			return nullptr;
+		}
+
+		FEnhancedScheduleEvent& Event = Events.AddDefaulted_GetRef();
+		Event.Time       = FCString::Atof(*Cells[0]);
+		Event.Event      = Cells.IsValidIndex(1) ? FName(*Cells[1]) : NAME_None;
+		Event.IntValue   = Cells.IsValidIndex(2) ? FCString::Atoi(*Cells[2]) : 0;
+		Event.FloatValue = Cells.IsValidIndex(3) ? FCString::Atof(*Cells[3]) : 0.f;
+	}
+	return CreateFromEvents(WorldContextObject, MoveTemp(Events), InDilationMode, InDilationActor, bInAffectedByGamePause, InWindowSize);
+}
+
+UEnhancedSchedulePlayback* UEnhancedSchedulePlayback::CreateFromEvents(UObject* WorldContextObject, TArray<FEnhancedScheduleEvent>&& InEvents,
+	EEnhancedTimerTimeDilationMode InDilationMode, AActor* InDilationActor, bool bInAffectedByGamePause, int32 InWindowSize)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UEnhancedTimerManagerSubsystem* TimerSubsystem = GameInstance ? GameInstance->GetSubsystem<UEnhancedTimerManagerSubsystem>() : nullptr;
+	if (!TimerSubsystem) return nullptr;
+
+	UEnhancedSchedulePlayback* Playback = NewObject<UEnhancedSchedulePlayback>(WorldContextObject);
+	Playback->Events               = MoveTemp(InEvents);
+	Playback->Subsystem            = TimerSubsystem;
+	Playback->DilationMode         = InDilationMode;
+	Playback->DilationActor        = InDilationActor;
+	Playback->bAffectedByGamePause = bInAffectedByGamePause;
+	Playback->WindowSize           = FMath::Max(1, InWindowSize);
+
+	// Stable: events with equal times keep their source order (which is also their fire order).
+	Algo::StableSortBy(Playback->Events, &FEnhancedScheduleEvent::Time);
+	return Playback;
+}
+
+void UEnhancedSchedulePlayback::Play()
+{
+	Stop();
+
+	UEnhancedTimerManagerSubsystem* TimerSubsystem = Subsystem.Get();
+	if (!TimerSubsystem || Events.Num() == 0) return;
+
+	// Window deadlines are measured against this clock so that they do not drift with per-fire frame quantization.
+	ClockTimer = TimerSubsystem->SetEnhancedTimer(FTimerDelegate(), MAX_flt, DilationMode, DilationActor.Get(), bAffectedByGamePause);
+	bPlaying = true;
+
+	WindowTimers.Reserve(WindowSize);
+	while (WindowTimers.Num() < WindowSize && NextToMaterialize < Events.Num())
+	{
+		MaterializeNext();
+	}
+}
+
+void UEnhancedSchedulePlayback::Stop()
+{
+	if (UEnhancedTimerManagerSubsystem* TimerSubsystem = Subsystem.Get())
+	{
+		TArray<FEnhancedTimerHandle> Handles;
+		WindowTimers.GenerateValueArray(Handles);
+		Handles.Add(ClockTimer);
+		TimerSubsystem->InvalidateTimers(Handles);
+	}
+
+	WindowTimers.Reset();
+	ClockTimer.Invalidate();
+	NextToMaterialize = 0;
+	NumFired          = 0;
+	bPlaying          = false;
+	bPaused           = false;
+}
+
+void UEnhancedSchedulePlayback::SetPaused(bool bInPaused)
+{
+	UEnhancedTimerManagerSubsystem* TimerSubsystem = Subsystem.Get();
+	if (!bPlaying || bPaused == bInPaused || !TimerSubsystem) return;
+
+	bPaused = bInPaused;
+	auto Apply = [TimerSubsystem, bInPaused](const FEnhancedTimerHandle& Handle)
+	{
+		if (bInPaused) TimerSubsystem->PauseTimer(Handle); else TimerSubsystem->UnpauseTimer(Handle);
+	};
+
+	Apply(ClockTimer);
+	for (const TPair<int32, FEnhancedTimerHandle>& Pair : WindowTimers)
+	{
+		Apply(Pair.Value);
+	}
+}
+
+float UEnhancedSchedulePlayback::GetPlaybackTime() const
+{
+	const UEnhancedTimerManagerSubsystem* TimerSubsystem = Subsystem.Get();
+	return (bPlaying && TimerSubsystem) ? FMath::Max(0.f, TimerSubsystem->GetTimerElapsedTime(ClockTimer)) : 0.f;
+}
+
+void UEnhancedSchedulePlayback::MaterializeNext()
+{
+	UEnhancedTimerManagerSubsystem* TimerSubsystem = Subsystem.Get();
+	if (!TimerSubsystem) return;
+
+	const int32 EventIndex = NextToMaterialize++;
+	const float Delay = FMath::Max(0.f, Events[EventIndex].Time - GetPlaybackTime());
+
+	FEnhancedTimerHandle Handle = TimerSubsystem->SetEnhancedTimer(
+		FTimerDelegate::CreateUObject(this, &UEnhancedSchedulePlayback::HandleEventTimer, EventIndex),
+		Delay, DilationMode, DilationActor.Get(), bAffectedByGamePause);
+	if (bPaused)
+	{
+		TimerSubsystem->PauseTimer(Handle);
+	}
+	WindowTimers.Add(EventIndex, Handle);
+}
+
+void UEnhancedSchedulePlayback::HandleEventTimer(int32 EventIndex)
+{
+	if (WindowTimers.Remove(EventIndex) == 0) return;   // stale timer of a previous Play()
+
+	++NumFired;
+
+	// Refill first so that listeners calling Stop() leave a clean state.
+	if (NextToMaterialize < Events.Num())
+	{
+		MaterializeNext();
+	}
+
+	const FEnhancedScheduleEvent Event = Events[EventIndex];
+	OnEvent.Broadcast(Event);
+
+	if (bPlaying && NumFired == Events.Num())
+	{
+		Stop();
+		OnFinished.Broadcast();
+	}
+}
+
+void UEnhancedSchedulePlayback::BeginDestroy()
+{
+	Stop();
+	Super::BeginDestroy();
+}
@@ -0,0 +1,80 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedThreadTimers.h"
+#include "HAL/PlatformTLS.h"
+
+FEnhancedThreadTimers::FEnhancedThreadTimers()
+	: LastServiceTime(FPlatformTime::Seconds())
+	, OwnerThreadId(FPlatformTLS::GetCurrentThreadId())
+{
+}
+
+FEnhancedThreadTimers& FEnhancedThreadTimers::Get()
+{
+	static thread_local FEnhancedThreadTimers Instance;
+	return Instance;
+}
+
+uint64 FEnhancedThreadTimers::AddTimer(float Seconds, bool bLoop, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token)
+{
+	CheckOwnerThread();
+
+	TEnhancedTimerSet<FCallback>::FTimer Timer;
+	Timer.Callback          = MoveTemp(Callback);
+	Timer.CancellationToken = Token;
+	Timer.Arm(Seconds, bLoop);
+
+	// The set clock only moves in Service(): the time since the last Service is still to be delivered,
+	// so the first period starts after it (i.e. now).
+	const float ClockLag = (float)(FPlatformTime::Seconds() - LastServiceTime);
+	return Timers.Emplace(MoveTemp(Timer), ClockLag).Id;
+}
+
+uint64 FEnhancedThreadTimers::SetTimeout(float Seconds, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token)
+{
+	return AddTimer(Seconds, false, MoveTemp(Callback), Token);
+}
+
+uint64 FEnhancedThreadTimers::SetInterval(float Seconds, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token)
+{
+	return AddTimer(Seconds, true, MoveTemp(Callback), Token);
+}
+
+bool FEnhancedThreadTimers::Cancel(uint64 Id)
+{
+	CheckOwnerThread();
+	return Timers.Remove(Id);
+}
+
+void FEnhancedThreadTimers::CancelAll()
+{
+	CheckOwnerThread();
+	Timers.Reset();
+}
+
+bool FEnhancedThreadTimers::IsPending(uint64 Id) const
+{
+	CheckOwnerThread();
+	return Timers.IsValid(Id);
+}
+
+int32 FEnhancedThreadTimers::Service()
+{
+	CheckOwnerThread();
+
+	const double Now = FPlatformTime::Seconds();
+	const float  DeltaTime = (float)(Now - LastServiceTime);
+	LastServiceTime = Now;
+	bServiced       = true;
+
+	return Timers.IsEmpty() ? 0 : Timers.Tick(DeltaTime);
+}
+
+float FEnhancedThreadTimers::GetWaitTime() const
+{
+	CheckOwnerThread();
+
+	const float UntilDue = Timers.GetTimeUntilNextDue();
+	if (UntilDue == MAX_flt) return MAX_flt;
+	return FMath::Max(0.f, UntilDue - (float)(FPlatformTime::Seconds() - LastServiceTime));
+}
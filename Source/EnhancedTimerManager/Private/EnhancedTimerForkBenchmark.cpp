@@ -0,0 +1,113 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerSet.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+#if PLATFORM_LINUX && !UE_BUILD_SHIPPING
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace EnhancedTimerForkBenchmark
+{
+	using FBenchSet = TEnhancedTimerSet<TFunction<void()>>;
+
+	static int64 GetMinorFaults()
+	{
+		struct rusage Usage;
+		getrusage(RUSAGE_SELF, &Usage);
+		return (int64)Usage.ru_minflt;
+	}
+
+	/**
+	 * Run Body in a forked child and return the minor page faults it caused (copy-on-write faults on memory
+	 * shared with the parent), or -1 on failure. The child only runs Body and exits without touching the engine.
+	 */
+	template<typename BodyType>
+	static int64 MeasureInChild(BodyType&& Body)
+	{
+		int Pipe[2];
+		if (pipe(Pipe) != 0) return -1;
+
+		const pid_t Pid = fork();
+		if (Pid < 0)
+		{
+			close(Pipe[0]);
+			close(Pipe[1]);
+			return -1;
+		}
+
+		if (Pid == 0)
+		{
+			close(Pipe[0]);
+			const int64 Before = GetMinorFaults();
+			Body();
+			const int64 Faults = GetMinorFaults() - Before;
+			(void)!write(Pipe[1], &Faults, sizeof(Faults));
+			_exit(0);
+		}
+
+		close(Pipe[1]);
+		int64 Faults = -1;
+		if (read(Pipe[0], &Faults, sizeof(Faults)) != sizeof(Faults))
+		{
+			Faults = -1;
+		}
+		close(Pipe[0]);
+		waitpid(Pid, nullptr, 0);
+		return Faults;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumTimers = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 600;
+		const float Delta     = 1.f / 60.f;
+
+		// Mostly long timers (as on an idle pre-forked server) plus a few short loops that fire every frame or so.
+		FBenchSet Timers;
+		Timers.Reserve(NumTimers);
+		int32 NumFired = 0;
+		FRandomStream Random(NumTimers);
+		for (int32 i = 0; i < NumTimers; ++i)
+		{
+			const bool  bShort   = (i % 100) == 0;
+			const float Duration = bShort ? Random.FRandRange(0.05f, 0.5f) : Random.FRandRange(60.f, 600.f);
+			Timers.Add([&NumFired]() { ++NumFired; }, Duration, bShort);
+		}
+
+		// Warm up so scratch arrays and heaps reach their steady-state capacity before forking:
+		// the child should not need the allocator.
+		for (int32 Frame = 0; Frame < 120; ++Frame)
+		{
+			Timers.Tick(Delta);
+		}
+
+		const int64 TickFaults = MeasureInChild([&Timers, NumFrames, Delta]()
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Timers.Tick(Delta);
+			}
+		});
+
+		// Reference: write every timer entry once, as a layout that updates each timer per frame would.
+		const int64 TouchFaults = MeasureInChild([&Timers]()
+		{
+			Timers.ForEachMutable([](FBenchSet::FTimer& T) { ++T.Priority; });
+		});
+
+		UE_LOG(LogEnhancedTimerManager, Log,
+			TEXT("Fork fault benchmark: %d timers, %d domains. Ticking %d frames in the child: %lld minor faults. Writing every entry once: %lld minor faults."),
+			Timers.Num(), Timers.NumDomains(), NumFrames, TickFaults, TouchFaults);
+	}
+}
+
+static FAutoConsoleCommand CmdEnhancedTimersForkFaultBenchmark(
+	TEXT("EnhancedTimers.ForkFaultBenchmark"),
+	TEXT("Measure copy-on-write page faults of ticking a timer set in a forked child. Args: [NumTimers=10000] [NumFrames=600]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&EnhancedTimerForkBenchmark::Run));
+
+#endif // PLATFORM_LINUX && !UE_BUILD_SHIPPING
@@ -0,0 +1,63 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerSet.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace EnhancedTimerInsertBenchmark
+{
+	/** Log mean, p99 and max of a slice of insert latencies (seconds); sorts Scratch. */
+	static void LogBand(const TCHAR* Label, TConstArrayView<double> Samples, int32 Start, int32 End, TArray<double>& Scratch)
+	{
+		Scratch.Reset(End - Start);
+		Scratch.Append(Samples.GetData() + Start, End - Start);
+		Scratch.Sort();
+
+		double Total = 0.0;
+		for (double Sample : Scratch) Total += Sample;
+
+		const int32 P99Index = FMath::Clamp((int32)FMath::CeilToDouble(Scratch.Num() * 0.99) - 1, 0, Scratch.Num() - 1);
+		UE_LOG(LogEnhancedTimerManager, Log, TEXT("Insert %s %8d..%8d: mean %.3f us, p99 %.3f us, max %.3f us"),
+			Label, Start, End, Total * 1.e6 / Scratch.Num(), Scratch[P99Index] * 1.e6, Scratch.Last() * 1.e6);
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumTimers = Args.Num() > 0 ? FMath::Max(1024, FCString::Atoi(*Args[0])) : 1024 * 1024;
+
+		TEnhancedTimerSet<TFunction<void()>> Timers;
+
+		TArray<double> Samples;
+		TArray<double> Scratch;
+		Samples.Reserve(NumTimers);
+		Scratch.Reserve(NumTimers);
+
+		// Report mean, p99 and worst insert per power-of-two band: a container that regrows by copying shows
+		// its spikes at the band boundaries, paged storage and the chunked deadline heap should stay flat.
+		int32 BandEnd   = 1024;
+		int32 BandStart = 0;
+		for (int32 i = 0; i < NumTimers; ++i)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Timers.Add([]() {}, 60.f + (float)(i % 1000));
+			Samples.Add(FPlatformTime::Seconds() - Start);
+
+			if (i + 1 == BandEnd || i + 1 == NumTimers)
+			{
+				LogBand(TEXT("band"), Samples, BandStart, i + 1, Scratch);
+				BandStart = i + 1;
+				BandEnd  *= 2;
+			}
+		}
+		LogBand(TEXT("all "), Samples, 0, NumTimers, Scratch);
+	}
+}
+
+static FAutoConsoleCommand CmdEnhancedTimersInsertBenchmark(
+	TEXT("EnhancedTimers.InsertBenchmark"),
+	TEXT("Log mean, p99 and worst timer insert latency per power-of-two band and overall. Args: [NumTimers=1048576]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&EnhancedTimerInsertBenchmark::Run));
+
+#endif // !UE_BUILD_SHIPPING
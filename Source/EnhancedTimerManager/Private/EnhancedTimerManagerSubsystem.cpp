@@ -1,35 +1,168 @@
 ﻿// Copyright (C) Thyke. All Rights Reserved.
 
 #include "EnhancedTimerManagerSubsystem.h"
+#include "EnhancedTimerReplicationProxy.h"
+#include "EnhancedTimerService.h"
 #include "Engine/World.h"
 #include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderCore.h"                  // GGameThreadTime
 
 DEFINE_LOG_CATEGORY(LogEnhancedTimerManager);
 
+static TAutoConsoleVariable<int32> CVarEnhancedTimersMaxReleasesPerFrame(
+    TEXT("EnhancedTimers.DeferredRelease.MaxPerFrame"),
+    0,
+    TEXT("Maximum deferred destroys/releases processed per frame (0 = no cap). Due entries over the cap wait for the next frames."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnhancedTimersBackgroundTargetFrameMs(
+    TEXT("EnhancedTimers.Background.TargetFrameMs"),
+    16.6f,
+    TEXT("Game thread frame time under which due Background-class timer callbacks are run (slack = target - last game thread time)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnhancedTimersBackgroundMaxDeferral(
+    TEXT("EnhancedTimers.Background.MaxDeferral"),
+    1.f,
+    TEXT("Seconds after which a due Background-class timer callback runs even without frame headroom."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEnhancedTimersEngine(
+    TEXT("EnhancedTimers.Engine"),
+    0,
+    TEXT("Deadline structure of the timer domains. 0 = adaptive (chosen from count, interval distribution and churn), 1 = heap, 2 = scan, 3 = wheel."),
+    ECVF_Default);
+
+namespace EnhancedTimerTickGroups
+{
+    static ETickingGroup ToEngineTickGroup(EEnhancedTimerTickGroup Group)
+    {
+        switch (Group)
+        {
+            case EEnhancedTimerTickGroup::PrePhysics:     return TG_PrePhysics;
+            case EEnhancedTimerTickGroup::DuringPhysics:  return TG_DuringPhysics;
+            case EEnhancedTimerTickGroup::PostPhysics:    return TG_PostPhysics;
+            case EEnhancedTimerTickGroup::PostUpdateWork: return TG_PostUpdateWork;
+            default:                                      return TG_PrePhysics;
+        }
+    }
+}
+
+// ===== FEnhancedTimerTickFunction =====
+
+void FEnhancedTimerTickFunction::ExecuteTick(float DeltaTime, ELevelTick /*TickType*/, ENamedThreads::Type /*CurrentThread*/, const FGraphEventRef& /*MyCompletionGraphEvent*/)
+{
+    if (Owner)
+    {
+        Owner->TickTimerGroup(Group, DeltaTime);
+    }
+}
+
+FString FEnhancedTimerTickFunction::DiagnosticMessage()
+{
+    return FString::Printf(TEXT("EnhancedTimerTickFunction[%s]"), *UEnum::GetValueAsString(Group));
+}
+
+FName FEnhancedTimerTickFunction::DiagnosticContext(bool /*bDetailed*/)
+{
+    return FName(TEXT("EnhancedTimerTickFunction"));
+}
+
+// ===== UEnhancedTimerManagerSubsystem =====
+
 void UEnhancedTimerManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
-    Timers.Reserve(256);
-    FiredThisTick.Reserve(128);
+    Groups[(int32)EEnhancedTimerTickGroup::Default].Timers.Reserve(256);
+    Groups[(int32)EEnhancedTimerTickGroup::Default].FiredThisTick.Reserve(128);
     ToRemove.Reserve(128);
     ToUnpause.Reserve(64);
     ReusableToFire.Reserve(128);
-    ReusableSnapshot.Reserve(256);
+    BackgroundQueue.Reserve(32);
+
+    // Keep the tag index in sync with every way a timer can leave its set (invalidate, completion, token drop).
+    for (int32 i = 0; i < NumTickGroups; ++i)
+    {
+        Groups[i].Timers.SetOnRemoved([this](const FEnhancedTimerData& T)
+        {
+            // Token drops during a shared service advance run on a worker: leave the indexes to the next tick.
+            if (!IsInGameThread())
+            {
+                SharedRemovedIds.Add(T.Id);
+                return;
+            }
+            ForgetRemovedTimer(T.Id);
+        });
+        Groups[i].Timers.SetOnEngineSwitched([i](const FEnhancedTimerDomain& Domain, EEnhancedTimerEngine OldEngine)
+        {
+            const FEnhancedTimerWorkload& W = Domain.Workload;
+            // The shared service switches engines on a worker, where the actor must not be resolved.
+            const FString ActorName = IsInGameThread() ? GetNameSafe(Domain.Key.Actor.Get()) : TEXT("?");
+            UE_LOG(LogEnhancedTimerManager, Log, TEXT("Timer engine: group %d domain (Mode=%d Actor=%s PauseTicking=%d) %s -> %s (timers=%d short=%.0f%% meanInterval=%.2fs churn=%.0f/s)"),
+                i, (int32)Domain.Key.DilationMode, *ActorName, (int32)Domain.Key.bTicksWhenPaused,
+                LexToString(OldEngine), LexToString(Domain.Engine),
+                W.NumTimers, W.ShortFraction * 100.f, W.MeanInterval, W.ChurnPerSecond);
+        });
+    }
+
+    for (int32 i = 1; i < NumTickGroups; ++i)
+    {
+        FEnhancedTimerTickFunction& TickFn = GroupTickFunctions[i];
+        TickFn.Owner                 = this;
+        TickFn.Group                 = (EEnhancedTimerTickGroup)i;
+        TickFn.TickGroup             = EnhancedTimerTickGroups::ToEngineTickGroup(TickFn.Group);
+        TickFn.bCanEverTick          = true;
+        TickFn.bStartWithTickEnabled = true;
+        TickFn.bTickEvenWhenPaused   = true;   // per-timer pause gate via bAffectedByGamePause
+    }
+
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UEnhancedTimerManagerSubsystem::HandleWorldCleanup);
+
+    if (FEnhancedTimerService::IsEnabled())
+    {
+        bUseSharedService = true;
+        FEnhancedTimerService::Get().Register(this);
+    }
 }
 
 void UEnhancedTimerManagerSubsystem::Deinitialize()
 {
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    if (bUseSharedService)
+    {
+        FEnhancedTimerService::Get().Unregister(this);
+        bUseSharedService = false;
+    }
+    UnregisterGroupTickFunctions();
+    ReleasePhysicsClock();
+    PhysicsCommands.Empty();
+
     Super::Deinitialize();
     {
         FWriteScopeLock _(MapLock);
-        Timers.Empty();
+        RateLimiters.Empty();
+        for (FTimerGroup& Group : Groups)
+        {
+            Group.Timers.Empty();
+        }
+        TimerTags.Empty();
+        TagIndex.Empty();
+        RetryStates.Empty();
+        TimerMilestones.Empty();
+        SharedRemovedIds.Empty();
+    }
+    for (FTimerGroup& Group : Groups)
+    {
+        Group.FiredThisTick.Empty();
     }
-    FiredThisTick.Empty();
     ToRemove.Empty();
     ToUnpause.Empty();
     ReusableToFire.Empty();
-    ReusableSnapshot.Empty();
-    NextId = 1;
+    BackgroundQueue.Empty();
+    IntervalTicks.Reset();
+    PollTimers.Reset();
+    DeferredRelease.Reset();
 }
 
 void UEnhancedTimerManagerSubsystem::EnforceGameThread() const
@@ -49,17 +182,16 @@ bool UEnhancedTimerManagerSubsystem::IsGamePaused() const
     return false;
 }
 
-uint64 UEnhancedTimerManagerSubsystem::AllocateId()
+const FEnhancedTimerData* UEnhancedTimerManagerSubsystem::FindTimer(uint64 Id) const
 {
-    uint64 Out = NextId++;
-    if (NextId == 0) { NextId = 1; } // wrap protection
-    return Out;
+    const int32 GroupIndex = GroupIndexFromId(Id);
+    return (Id != 0 && GroupIndex < NumTickGroups) ? Groups[GroupIndex].Timers.Find(Id) : nullptr;
 }
 
 bool UEnhancedTimerManagerSubsystem::GetData(uint64 Id, FEnhancedTimerData& Out) const
 {
     FReadScopeLock _(MapLock);
-    if (const FEnhancedTimerData* Found = Timers.Find(Id))
+    if (const FEnhancedTimerData* Found = FindTimer(Id))
     {
         Out = *Found;
         return true;
@@ -70,7 +202,28 @@ bool UEnhancedTimerManagerSubsystem::GetData(uint64 Id, FEnhancedTimerData& Out)
 FEnhancedTimerData* UEnhancedTimerManagerSubsystem::FindMutable(uint64 Id)
 {
     FWriteScopeLock _(MapLock);
-    return Timers.Find(Id);
+    return const_cast<FEnhancedTimerData*>(FindTimer(Id));
+}
+
+const FEnhancedTimerSet* UEnhancedTimerManagerSubsystem::FindSet(uint64 Id) const
+{
+    const int32 GroupIndex = GroupIndexFromId(Id);
+    return (Id != 0 && GroupIndex < NumTickGroups) ? &Groups[GroupIndex].Timers : nullptr;
+}
+
+uint64 UEnhancedTimerManagerSubsystem::AddTimer(FEnhancedTimerData&& Data, EEnhancedTimerTickGroup Group)
+{
+    uint64 Id = 0;
+    {
+        // The set allocates the Id and stores the tick group in its low bits (see GroupIndexFromId).
+        FWriteScopeLock _(MapLock);
+        Id = Groups[(int32)Group].Timers.Emplace(MoveTemp(Data), 0.f, (uint32)Group).Id;
+    }
+    if (Group != EEnhancedTimerTickGroup::Default)
+    {
+        RequestGroupTick(Group);
+    }
+    return Id;
 }
 
 FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer(const FTimerDelegate& InDelegate,
@@ -80,7 +233,8 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer(const FTim
                                                                       bool bAffectedByGamePause,
                                                                       bool bLoop,
                                                                       float DelayToStartCountingDown,
-                                                                      float DelayToStartCountingDownVariation)
+                                                                      float DelayToStartCountingDownVariation,
+                                                                      EEnhancedTimerTickGroup TickGroup)
 {
     EnforceGameThread();
     if (!IsInGameThread())
@@ -88,20 +242,17 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer(const FTim
         FTimerDelegate Copy = InDelegate;
         AsyncTask(ENamedThreads::GameThread, [this, Copy, Duration, DilationMode, DilationActor,
                                               bAffectedByGamePause, bLoop,
-                                              DelayToStartCountingDown, DelayToStartCountingDownVariation]()
+                                              DelayToStartCountingDown, DelayToStartCountingDownVariation, TickGroup]()
         {
             SetEnhancedTimer(Copy, Duration, DilationMode, DilationActor, bAffectedByGamePause,
-                             bLoop, DelayToStartCountingDown, DelayToStartCountingDownVariation);
+                             bLoop, DelayToStartCountingDown, DelayToStartCountingDownVariation, TickGroup);
         });
         return FEnhancedTimerHandle(); // invalid handle when called off-thread; prefer SetEnhancedTimerAsync to capture the handle
     }
 
     FEnhancedTimerData Data;
-    Data.Id                   = AllocateId();
-    Data.Delegate             = InDelegate;
-    Data.bUseDynamic          = false;
+    Data.Callback.Delegate    = InDelegate;
     Data.Duration             = FMath::Max(0.f, Duration);
-    Data.PhaseElapsed         = 0.f;
     Data.InitialDelay         = 0.f;
     Data.Phase                = FEnhancedTimerData::ETimerPhase::Running;
     Data.bLoop                = bLoop;
@@ -119,37 +270,31 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer(const FTim
         if (Data.InitialDelay > 0.f)
         {
             Data.Phase       = FEnhancedTimerData::ETimerPhase::InitialDelay;
-            Data.PhaseElapsed = 0.f;
         }
     }
 
-    {
-        FWriteScopeLock _(MapLock);
-        Timers.Add(Data.Id, MoveTemp(Data));
-    }
+    const uint64 Id = AddTimer(MoveTemp(Data), TickGroup);
 
-    return FEnhancedTimerHandle(Data.Id, this);
+    return FEnhancedTimerHandle(Id, this);
 }
 
-FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate)
+FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate,
+                                                                                       EEnhancedTimerTickGroup TickGroup)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
         FTimerDelegate Copy = InDelegate;
-        AsyncTask(ENamedThreads::GameThread, [this, Copy]()
+        AsyncTask(ENamedThreads::GameThread, [this, Copy, TickGroup]()
         {
-            SetEnhancedTimerExecutedInNextTick(Copy);
+            SetEnhancedTimerExecutedInNextTick(Copy, TickGroup);
         });
         return FEnhancedTimerHandle();
     }
 
     FEnhancedTimerData Data;
-    Data.Id                   = AllocateId();
-    Data.Delegate             = InDelegate;
-    Data.bUseDynamic          = false;
+    Data.Callback.Delegate    = InDelegate;
     Data.Duration             = 0.f;
-    Data.PhaseElapsed         = 0.f;
     Data.InitialDelay         = 0.f;
     Data.Phase                = FEnhancedTimerData::ETimerPhase::Running;
     Data.bLoop                = false;
@@ -158,12 +303,9 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInN
     Data.DilationMode         = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
     Data.bNextTick            = true;
 
-    {
-        FWriteScopeLock _(MapLock);
-        Timers.Add(Data.Id, MoveTemp(Data));
-    }
+    const uint64 Id = AddTimer(MoveTemp(Data), TickGroup);
 
-    return FEnhancedTimerHandle(Data.Id, this);
+    return FEnhancedTimerHandle(Id, this);
 }
 
 FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer_BP(const UObject* /*WorldContextObject*/,
@@ -174,27 +316,26 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer_BP(const U
     bool bAffectedByGamePause,
     bool bLoop,
     float DelayToStartCountingDown,
-    float DelayToStartCountingDownVariation)
+    float DelayToStartCountingDownVariation,
+    EEnhancedTimerTickGroup TickGroup)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
         AsyncTask(ENamedThreads::GameThread, [this, Event, Duration, DilationMode, DilationActor,
                                               bAffectedByGamePause, bLoop,
-                                              DelayToStartCountingDown, DelayToStartCountingDownVariation]()
+                                              DelayToStartCountingDown, DelayToStartCountingDownVariation, TickGroup]()
         {
             SetEnhancedTimer_BP(nullptr, Event, Duration, DilationMode, DilationActor, bAffectedByGamePause,
-                                bLoop, DelayToStartCountingDown, DelayToStartCountingDownVariation);
+                                bLoop, DelayToStartCountingDown, DelayToStartCountingDownVariation, TickGroup);
         });
         return FEnhancedTimerHandle();
     }
 
     FEnhancedTimerData Data;
-    Data.Id                   = AllocateId();
-    Data.DynamicDelegate      = Event;
-    Data.bUseDynamic          = true;
+    Data.Callback.DynamicDelegate = Event;
+    Data.Callback.bUseDynamic     = true;
     Data.Duration             = FMath::Max(0.f, Duration);
-    Data.PhaseElapsed         = 0.f;
     Data.InitialDelay         = 0.f;
     Data.Phase                = FEnhancedTimerData::ETimerPhase::Running;
     Data.bLoop                = bLoop;
@@ -212,37 +353,32 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimer_BP(const U
         if (Data.InitialDelay > 0.f)
         {
             Data.Phase       = FEnhancedTimerData::ETimerPhase::InitialDelay;
-            Data.PhaseElapsed = 0.f;
         }
     }
 
-    {
-        FWriteScopeLock _(MapLock);
-        Timers.Add(Data.Id, MoveTemp(Data));
-    }
+    const uint64 Id = AddTimer(MoveTemp(Data), TickGroup);
 
-    return FEnhancedTimerHandle(Data.Id, this);
+    return FEnhancedTimerHandle(Id, this);
 }
 
 FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInNextTick_BP(const UObject* /*WorldContextObject*/,
-    const FTimerDynamicDelegate& Event)
+    const FTimerDynamicDelegate& Event,
+    EEnhancedTimerTickGroup TickGroup)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
-        AsyncTask(ENamedThreads::GameThread, [this, Event]()
+        AsyncTask(ENamedThreads::GameThread, [this, Event, TickGroup]()
         {
-            SetEnhancedTimerExecutedInNextTick_BP(nullptr, Event);
+            SetEnhancedTimerExecutedInNextTick_BP(nullptr, Event, TickGroup);
         });
         return FEnhancedTimerHandle();
     }
 
     FEnhancedTimerData Data;
-    Data.Id                   = AllocateId();
-    Data.DynamicDelegate      = Event;
-    Data.bUseDynamic          = true;
+    Data.Callback.DynamicDelegate = Event;
+    Data.Callback.bUseDynamic     = true;
     Data.Duration             = 0.f;
-    Data.PhaseElapsed         = 0.f;
     Data.InitialDelay         = 0.f;
     Data.Phase                = FEnhancedTimerData::ETimerPhase::Running;
     Data.bLoop                = false;
@@ -251,12 +387,9 @@ FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInN
     Data.DilationMode         = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
     Data.bNextTick            = true;
 
-    {
-        FWriteScopeLock _(MapLock);
-        Timers.Add(Data.Id, MoveTemp(Data));
-    }
+    const uint64 Id = AddTimer(MoveTemp(Data), TickGroup);
 
-    return FEnhancedTimerHandle(Data.Id, this);
+    return FEnhancedTimerHandle(Id, this);
 }
 
 void UEnhancedTimerManagerSubsystem::Tick(float DeltaTime)
@@ -264,126 +397,257 @@ void UEnhancedTimerManagerSubsystem::Tick(float DeltaTime)
     UWorld* World = GetWorld();
     if (!World) return;
 
-#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
-    const uint64 StartCycles = FPlatformTime::Cycles64();
-    TimersProcessedLastTick = 0;
-#endif
+    // Keep the group tick functions registered in the current world (map travel, PIE restart).
+    if (TickFunctionsWorld.Get() != World)
+    {
+        RegisterGroupTickFunctions(World);
+    }
 
-    const bool bPausedNow = IsGamePaused();
+    RefreshEngineSettings();
+    DrainPhysicsCommands();
 
-    // --- Snapshot phase (short read lock) ---
-    ReusableSnapshot.Reset(Timers.Num());
+    if (bUseSharedService)
     {
-        FReadScopeLock RLock(MapLock);
-        for (const auto& Pair : Timers)
-        {
-            ReusableSnapshot.Emplace(Pair.Key, Pair.Value);
-        }
+        // Advanced on a worker by the shared service; only fire here.
+        SharedPendingDelta += DeltaTime;
+        FlushSharedRemovals();
+        ExecuteFired(Groups[(int32)EEnhancedTimerTickGroup::Default]);
+        Cleanup();
     }
-
-    // --- Quick pass without lock: pre-mark next-tick timers ---
-    for (const auto& Pair : ReusableSnapshot)
+    else
     {
-        const FEnhancedTimerData& T = Pair.Value;
+        TickTimerGroup(EEnhancedTimerTickGroup::Default, DeltaTime);
+    }
 
-        if (T.bPaused) continue;
-        if (bPausedNow && !T.bAffectedByGamePause) continue;
+    IntervalTicks.Tick(DeltaTime, World, IsGamePaused());
+    PollTimers.Tick(DeltaTime, World, IsGamePaused());
+    DeferredRelease.Tick(DeltaTime, World, IsGamePaused(), CVarEnhancedTimersMaxReleasesPerFrame.GetValueOnGameThread());
 
-        if (T.bNextTick)
-        {
-            FiredThisTick.Add(Pair.Key);
-            continue;
-        }
-    }
+    // Last timer work of the frame (after every tick group): spend the remaining headroom on background callbacks.
+    DrainBackgroundQueue();
 
-    // --- Mutable pass: update elapsed / phases and collect fires (single write lock) ---
+    if (ReplicationProxy.IsValid() && World->GetNetMode() != NM_Client)
     {
-        FWriteScopeLock WLock(MapLock);
-        for (TPair<uint64, FEnhancedTimerData>& Pair : Timers)
-        {
-            FEnhancedTimerData& T = Pair.Value;
+        UpdateReplicatedTimers(World);
+    }
+}
 
-            if (T.bPaused) continue;
-            if (bPausedNow && !T.bAffectedByGamePause) continue;
+void UEnhancedTimerManagerSubsystem::RefreshEngineSettings()
+{
+    const int32 Mode = FMath::Clamp(CVarEnhancedTimersEngine.GetValueOnGameThread(), 0, 3);
+    if (Mode == AppliedEngineMode) return;
+    AppliedEngineMode = Mode;
 
-            if (T.bNextTick) continue;
+    FEnhancedTimerEngineSettings Settings;
+    Settings.bAdaptive    = Mode == 0;
+    Settings.ForcedEngine = Mode == 2 ? EEnhancedTimerEngine::Scan : Mode == 3 ? EEnhancedTimerEngine::Wheel : EEnhancedTimerEngine::Heap;
 
-            const float Eff = T.GetEffectiveDelta(DeltaTime, World);
-            T.Advance(Eff);
+    // Forced engines are applied by each domain's next advance (a safe point between fires).
+    FWriteScopeLock _(MapLock);
+    for (FTimerGroup& Group : Groups)
+    {
+        Group.Timers.SetEngineSettings(Settings);
+    }
+}
 
-            if (T.TryTransitFromDelay())
-            {
-                // Just transitioned to Running; do not fire on transition.
-                continue;
-            }
+void UEnhancedTimerManagerSubsystem::TickTimerGroup(EEnhancedTimerTickGroup InGroup, float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    if (!World) return;
 
-            if (T.ShouldFire())
-            {
-                FiredThisTick.Add(Pair.Key);
-            }
+    FTimerGroup& Group = Groups[(int32)InGroup];
 
 #if WITH_EDITOR || UE_BUILD_DEVELOPMENT
-            ++TimersProcessedLastTick;
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    BeginFrameStats();
+#endif
+
+    const bool bPausedNow = IsGamePaused();
+
+    // --- Advance phases and collect fires (single write lock) ---
+    {
+        FWriteScopeLock WLock(MapLock);
+#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
+        TimersProcessedLastTick += Group.Timers.Advance(DeltaTime, World, bPausedNow, Group.FiredThisTick);
+#else
+        Group.Timers.Advance(DeltaTime, World, bPausedNow, Group.FiredThisTick);
 #endif
-        }
     }
 
-    ExecuteFired();
+    ExecuteFired(Group);
     Cleanup();
 
 #if WITH_EDITOR || UE_BUILD_DEVELOPMENT
     const uint64 EndCycles = FPlatformTime::Cycles64();
-    LastTickTimeMs = FPlatformTime::ToMilliseconds64(EndCycles - StartCycles);
+    LastTickTimeMs += FPlatformTime::ToMilliseconds64(EndCycles - StartCycles);
+#endif
+}
+
+void UEnhancedTimerManagerSubsystem::BeginFrameStats()
+{
+#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
+    if (StatsFrameCounter != GFrameCounter)
+    {
+        // Stats cover every tick group of the frame.
+        StatsFrameCounter       = GFrameCounter;
+        LastTickTimeMs          = 0.0;
+        TimersProcessedLastTick = 0;
+    }
+#endif
+}
+
+bool UEnhancedTimerManagerSubsystem::BeginSharedAdvance()
+{
+    FTimerGroup& Group = Groups[(int32)EEnhancedTimerTickGroup::Default];
+
+    // Previous advance not fired yet (world did not tick): keep accumulating.
+    if (Group.FiredThisTick.Num() > 0) return false;
+
+    const UWorld* World = GetWorld();
+    SharedAdvanceDelta = SharedPendingDelta;
+    SharedPendingDelta = 0.f;
+    if (!World) return false;
+
+    {
+        FReadScopeLock _(MapLock);
+        if (!Group.Timers.HasActiveDomains()) return false;   // idle instance (held clocks, e.g. rate limiters, still advance)
+
+        // Dilation reads the world and actors: resolve it here, the worker only applies the rates.
+        Group.Timers.ResolveDomainRates(World, SharedDomainRates);
+    }
+
+    bSharedGamePaused = IsGamePaused();
+    BeginFrameStats();
+    return true;
+}
+
+void UEnhancedTimerManagerSubsystem::RunSharedAdvance()
+{
+    FTimerGroup& Group = Groups[(int32)EEnhancedTimerTickGroup::Default];
+
+    FWriteScopeLock WLock(MapLock);
+#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
+    TimersProcessedLastTick += Group.Timers.Advance(SharedAdvanceDelta, SharedDomainRates, bSharedGamePaused, Group.FiredThisTick);
+#else
+    Group.Timers.Advance(SharedAdvanceDelta, SharedDomainRates, bSharedGamePaused, Group.FiredThisTick);
 #endif
 }
 
-void UEnhancedTimerManagerSubsystem::ExecuteFired()
+void UEnhancedTimerManagerSubsystem::FlushSharedRemovals()
 {
-    if (FiredThisTick.Num() == 0) return;
+    if (SharedRemovedIds.Num() == 0) return;
 
-    // Use reusable buffer to avoid per-tick allocations.
-    ReusableToFire.Reset(FiredThisTick.Num());
-    ReusableToFire.Append(FiredThisTick);
-    FiredThisTick.Reset();
+    FWriteScopeLock _(MapLock);
+    for (uint64 Id : SharedRemovedIds)
+    {
+        ForgetRemovedTimer(Id);
+    }
+    SharedRemovedIds.Reset();
+}
 
-    for (uint64 Id : ReusableToFire)
+void UEnhancedTimerManagerSubsystem::ForgetRemovedTimer(uint64 Id)
+{
+    UnindexTimerTags(Id);
+    if (RetryStates.Num() > 0)
+    {
+        RetryStates.Remove(Id);
+    }
+    if (TimerMilestones.Num() > 0)
     {
-        FEnhancedTimerData Copy;
-        const bool bHave = GetData(Id, Copy);
-        if (!bHave) continue;
+        TimerMilestones.Remove(Id);
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::ExecuteFired(FTimerGroup& Group)
+{
+    if (Group.FiredThisTick.Num() == 0) return;
 
-        // Execute the bound delegate
-        if (Copy.bUseDynamic)
+    // Use reusable buffer to avoid per-tick allocations (FiredThisTick is already in fire order).
+    ReusableToFire.Reset(Group.FiredThisTick.Num());
+    ReusableToFire.Append(Group.FiredThisTick);
+    Group.FiredThisTick.Reset();
+
+    for (const FEnhancedFiredTimer& Fired : ReusableToFire)
+    {
+        if (Fired.Milestone != INDEX_NONE)
         {
-            if (Copy.DynamicDelegate.IsBound())
-            {
-                Copy.DynamicDelegate.ProcessDelegate<UObject>(nullptr);
-            }
+            FireMilestone(Fired.Id, Fired.Milestone);
         }
         else
         {
-            if (Copy.Delegate.IsBound())
-            {
-                Copy.Delegate.Execute();
-            }
+            FireAndComplete(Fired.Id);
         }
+    }
+}
 
-        // Post-fire handling
-        if (FEnhancedTimerData* Mut = FindMutable(Id))
-        {
-            if (Mut->bLoop)
-            {
-                // For looping timers, reset phase to Running and elapsed to 0.
-                Mut->Phase        = FEnhancedTimerData::ETimerPhase::Running;
-                Mut->PhaseElapsed = 0.f;
-                Mut->bNextTick    = false;
-            }
-            else
-            {
-                ToRemove.Add(Id);
-            }
-        }
+void UEnhancedTimerManagerSubsystem::FireMilestone(uint64 Id, int32 Milestone)
+{
+    // Milestones do not complete the timer; call from a copy so the callback may change or invalidate it.
+    FEnhancedTimerMilestone Copy;
+    {
+        FReadScopeLock _(MapLock);
+        const FEnhancedTimerData* T = FindTimer(Id);
+        const TArray<FEnhancedTimerMilestone>* Milestones = TimerMilestones.Find(Id);
+        if (!T || T->IsCancelled() || !Milestones || !Milestones->IsValidIndex(Milestone)) return;
+        Copy = (*Milestones)[Milestone];
+    }
+    Copy.Callback.ExecuteIfBound(Copy.TimeRemaining);
+}
+
+bool UEnhancedTimerManagerSubsystem::FireAndComplete(uint64 Id)
+{
+    // Fire from a copy so callbacks may freely create or invalidate timers.
+    FEnhancedTimerData Copy;
+    const bool bHave = GetData(Id, Copy);
+    if (!bHave) return false;
+
+    // Token may have been cancelled by a callback that ran earlier this frame.
+    if (Copy.IsCancelled())
+    {
+        ToRemove.Add(Id);
+        return false;
+    }
+
+    // Background timers stay fired (not re-armed) until the queue runs them.
+    if (Copy.PriorityClass == EEnhancedTimerPriorityClass::Background
+        && !BackgroundQueue.ContainsByPredicate([Id](const FBackgroundFire& Queued) { return Queued.Id == Id; }))
+    {
+        BackgroundQueue.Add({ Id, FPlatformTime::Seconds() });
+        return false;
+    }
+
+    Copy.Callback();
+
+    // Post-fire handling: re-arm loops, drop one-shots.
+    FWriteScopeLock _(MapLock);
+    Groups[GroupIndexFromId(Id)].Timers.CompleteFired(Id);
+    return true;
+}
+
+void UEnhancedTimerManagerSubsystem::DrainBackgroundQueue()
+{
+    if (BackgroundQueue.Num() == 0) return;
+
+    // Headroom left by the previous frame's game thread work.
+    const double Start        = FPlatformTime::Seconds();
+    const double SlackSeconds = (CVarEnhancedTimersBackgroundTargetFrameMs.GetValueOnGameThread() - FPlatformTime::ToMilliseconds(GGameThreadTime)) / 1000.0;
+    const double MaxDeferral  = CVarEnhancedTimersBackgroundMaxDeferral.GetValueOnGameThread();
+
+    int32 NumDrained = 0;
+    for (; NumDrained < BackgroundQueue.Num(); ++NumDrained)
+    {
+        const FBackgroundFire Entry = BackgroundQueue[NumDrained];
+        const double Now = FPlatformTime::Seconds();
+        const bool bOverdue = Now - Entry.QueuedTime >= MaxDeferral;
+        if (!bOverdue && Now - Start >= SlackSeconds) break;
+
+        // Mark as dequeued first so FireAndComplete runs it instead of queueing it again.
+        BackgroundQueue[NumDrained].Id = 0;
+        FireAndComplete(Entry.Id);
     }
+
+    BackgroundQueue.RemoveAt(0, NumDrained, EAllowShrinking::No);
+    Cleanup();
 }
 
 void UEnhancedTimerManagerSubsystem::Cleanup()
@@ -394,15 +658,15 @@ void UEnhancedTimerManagerSubsystem::Cleanup()
 
     for (uint64 Id : ToRemove)
     {
-        Timers.Remove(Id);
+        Groups[GroupIndexFromId(Id)].Timers.Remove(Id);
     }
     ToRemove.Reset();
 
     for (uint64 Id : ToUnpause)
     {
-        if (FEnhancedTimerData* T = Timers.Find(Id))
+        if (Id != 0 && GroupIndexFromId(Id) < NumTickGroups)
         {
-            T->bPaused = false;
+            Groups[GroupIndexFromId(Id)].Timers.SetPaused(Id, false);
         }
     }
     ToUnpause.Reset();
@@ -414,7 +678,8 @@ bool UEnhancedTimerManagerSubsystem::IsTimerValid(const FEnhancedTimerHandle& Ha
 {
     if (Handle.Id == 0) return false;
     FReadScopeLock _(MapLock);
-    return Timers.Contains(Handle.Id);
+    const FEnhancedTimerData* T = FindTimer(Handle.Id);
+    return T && !T->IsCancelled();
 }
 
 void UEnhancedTimerManagerSubsystem::InvalidateTimer(const FEnhancedTimerHandle& Handle)
@@ -426,9 +691,9 @@ void UEnhancedTimerManagerSubsystem::InvalidateTimer(const FEnhancedTimerHandle&
         return;
     }
 
-    if (Handle.Id == 0) return;
+    if (Handle.Id == 0 || GroupIndexFromId(Handle.Id) >= NumTickGroups) return;
     FWriteScopeLock _(MapLock);
-    Timers.Remove(Handle.Id);
+    Groups[GroupIndexFromId(Handle.Id)].Timers.Remove(Handle.Id);
 }
 
 bool UEnhancedTimerManagerSubsystem::IsTimerPaused(const FEnhancedTimerHandle& Handle) const
@@ -446,10 +711,9 @@ void UEnhancedTimerManagerSubsystem::PauseTimer(const FEnhancedTimerHandle& Hand
         return;
     }
 
-    if (FEnhancedTimerData* T = FindMutable(Handle.Id))
-    {
-        T->bPaused = true;
-    }
+    if (Handle.Id == 0 || GroupIndexFromId(Handle.Id) >= NumTickGroups) return;
+    FWriteScopeLock _(MapLock);
+    Groups[GroupIndexFromId(Handle.Id)].Timers.SetPaused(Handle.Id, true);
 }
 
 void UEnhancedTimerManagerSubsystem::UnpauseTimer(const FEnhancedTimerHandle& Handle)
@@ -461,10 +725,9 @@ void UEnhancedTimerManagerSubsystem::UnpauseTimer(const FEnhancedTimerHandle& Ha
         return;
     }
 
-    if (FEnhancedTimerData* T = FindMutable(Handle.Id))
-    {
-        T->bPaused = false;
-    }
+    if (Handle.Id == 0 || GroupIndexFromId(Handle.Id) >= NumTickGroups) return;
+    FWriteScopeLock _(MapLock);
+    Groups[GroupIndexFromId(Handle.Id)].Timers.SetPaused(Handle.Id, false);
 }
 
 bool UEnhancedTimerManagerSubsystem::IsTimerLooping(const FEnhancedTimerHandle& Handle) const
@@ -481,21 +744,18 @@ float UEnhancedTimerManagerSubsystem::GetTimerDuration(const FEnhancedTimerHandl
 
 float UEnhancedTimerManagerSubsystem::GetTimerTimeLeft(const FEnhancedTimerHandle& Handle) const
 {
-    FEnhancedTimerData T;
-    if (!GetData(Handle.Id, T)) return -1.f;
-
-    if (T.Phase == FEnhancedTimerData::ETimerPhase::InitialDelay)
-    {
-        const float RemDelay = FMath::Max(0.f, T.InitialDelay - T.PhaseElapsed);
-        return RemDelay;
-    }
-    return FMath::Max(0.f, T.Duration - T.PhaseElapsed);
+    FReadScopeLock _(MapLock);
+    const FEnhancedTimerSet*  Set = FindSet(Handle.Id);
+    const FEnhancedTimerData* T   = Set ? Set->Find(Handle.Id) : nullptr;
+    return T ? Set->GetTimeLeft(*T) : -1.f;
 }
 
 float UEnhancedTimerManagerSubsystem::GetTimerElapsedTime(const FEnhancedTimerHandle& Handle) const
 {
-    FEnhancedTimerData T;
-    return GetData(Handle.Id, T) ? T.PhaseElapsed : -1.f;
+    FReadScopeLock _(MapLock);
+    const FEnhancedTimerSet*  Set = FindSet(Handle.Id);
+    const FEnhancedTimerData* T   = Set ? Set->Find(Handle.Id) : nullptr;
+    return T ? Set->GetPhaseElapsed(*T) : -1.f;
 }
 
 bool UEnhancedTimerManagerSubsystem::IsTimerAffectedByGamePause(const FEnhancedTimerHandle& Handle) const
@@ -510,73 +770,1224 @@ EEnhancedTimerTimeDilationMode UEnhancedTimerManagerSubsystem::GetTimerTimeDilat
     return GetData(Handle.Id, T) ? T.DilationMode : EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
 }
 
-// ===== Bulk operations =====
+EEnhancedTimerTickGroup UEnhancedTimerManagerSubsystem::GetTimerTickGroup(const FEnhancedTimerHandle& Handle) const
+{
+    // Encoded in the Id; no lookup needed beyond validity.
+    return IsTimerValid(Handle) ? (EEnhancedTimerTickGroup)GroupIndexFromId(Handle.Id) : EEnhancedTimerTickGroup::Default;
+}
 
-void UEnhancedTimerManagerSubsystem::InvalidateAllTimers()
+int32 UEnhancedTimerManagerSubsystem::GetTimerPriority(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FEnhancedTimerData* T = FindTimer(Handle.Id);
+    return T ? T->Priority : 0;
+}
+
+void UEnhancedTimerManagerSubsystem::SetTimerPriority(const FEnhancedTimerHandle& Handle, int32 Priority)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
-        AsyncTask(ENamedThreads::GameThread, [this]() { InvalidateAllTimers(); });
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Priority]() { SetTimerPriority(Handle, Priority); });
         return;
     }
 
-    FWriteScopeLock _(MapLock);
-    Timers.Empty();
+    if (FEnhancedTimerData* T = FindMutable(Handle.Id))
+    {
+        T->Priority = Priority;
+    }
 }
 
-void UEnhancedTimerManagerSubsystem::PauseAllTimers()
+EEnhancedTimerPriorityClass UEnhancedTimerManagerSubsystem::GetTimerPriorityClass(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FEnhancedTimerData* T = FindTimer(Handle.Id);
+    return T ? T->PriorityClass : EEnhancedTimerPriorityClass::Normal;
+}
+
+void UEnhancedTimerManagerSubsystem::SetTimerPriorityClass(const FEnhancedTimerHandle& Handle, EEnhancedTimerPriorityClass PriorityClass)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
-        AsyncTask(ENamedThreads::GameThread, [this]() { PauseAllTimers(); });
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, PriorityClass]() { SetTimerPriorityClass(Handle, PriorityClass); });
         return;
     }
 
-    FWriteScopeLock _(MapLock);
-    for (TPair<uint64, FEnhancedTimerData>& Pair : Timers)
+    if (FEnhancedTimerData* T = FindMutable(Handle.Id))
     {
-        Pair.Value.bPaused = true;
+        T->PriorityClass = PriorityClass;
     }
 }
 
-void UEnhancedTimerManagerSubsystem::UnpauseAllTimers()
+void UEnhancedTimerManagerSubsystem::SetTimerCancellationToken(const FEnhancedTimerHandle& Handle, const FEnhancedTimerCancellationToken& Token)
 {
     EnforceGameThread();
     if (!IsInGameThread())
     {
-        AsyncTask(ENamedThreads::GameThread, [this]() { UnpauseAllTimers(); });
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Token]() { SetTimerCancellationToken(Handle, Token); });
+        return;
+    }
+
+    if (FEnhancedTimerData* T = FindMutable(Handle.Id))
+    {
+        T->CancellationToken = Token;
+    }
+}
+
+float UEnhancedTimerManagerSubsystem::GetTimerTimeScale(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FEnhancedTimerData* T = FindTimer(Handle.Id);
+    return T ? T->TimeScale : 1.f;
+}
+
+void UEnhancedTimerManagerSubsystem::SetTimerTimeScale(const FEnhancedTimerHandle& Handle, float TimeScale)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, TimeScale]() { SetTimerTimeScale(Handle, TimeScale); });
+        return;
+    }
+
+    if (Handle.Id == 0 || GroupIndexFromId(Handle.Id) >= NumTickGroups) return;
+    FWriteScopeLock _(MapLock);
+    Groups[GroupIndexFromId(Handle.Id)].Timers.SetTimeScale(Handle.Id, TimeScale);
+}
+
+void UEnhancedTimerManagerSubsystem::SetTimerMilestones(const FEnhancedTimerHandle& Handle, TArray<FEnhancedTimerMilestone> Milestones)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Milestones]() mutable { SetTimerMilestones(Handle, MoveTemp(Milestones)); });
         return;
     }
 
+    if (Handle.Id == 0 || GroupIndexFromId(Handle.Id) >= NumTickGroups) return;
+
+    // The set takes the thresholds largest first; callbacks keep the same order.
+    Milestones.RemoveAll([](const FEnhancedTimerMilestone& Milestone) { return Milestone.TimeRemaining <= 0.f; });
+    Milestones.StableSort([](const FEnhancedTimerMilestone& A, const FEnhancedTimerMilestone& B) { return A.TimeRemaining > B.TimeRemaining; });
+
+    TArray<float, TInlineAllocator<8>> TimesRemaining;
+    for (const FEnhancedTimerMilestone& Milestone : Milestones)
+    {
+        TimesRemaining.Add(Milestone.TimeRemaining);
+    }
+
     FWriteScopeLock _(MapLock);
-    for (TPair<uint64, FEnhancedTimerData>& Pair : Timers)
+    if (!FindTimer(Handle.Id)) return;
+
+    Groups[GroupIndexFromId(Handle.Id)].Timers.SetMilestones(Handle.Id, TimesRemaining);
+    if (Milestones.Num() > 0)
+    {
+        TimerMilestones.Add(Handle.Id, MoveTemp(Milestones));
+    }
+    else
     {
-        Pair.Value.bPaused = false;
+        TimerMilestones.Remove(Handle.Id);
     }
 }
 
-#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
-void UEnhancedTimerManagerSubsystem::DumpActiveTimers() const
+void UEnhancedTimerManagerSubsystem::SetTimerMilestones_BP(FEnhancedTimerHandle Handle, const TArray<float>& TimesRemaining, const FEnhancedTimerMilestoneDynamicDelegate& Event)
 {
-    FReadScopeLock RLock(MapLock);
-    UE_LOG(LogEnhancedTimerManager, Log, TEXT("Active timers: %d, LastTick=%.3f ms, Processed=%d"),
-        Timers.Num(), LastTickTimeMs, TimersProcessedLastTick);
-
-    for (const auto& P : Timers)
-    {
-        const auto& T = P.Value;
-        UE_LOG(LogEnhancedTimerManager, Log, TEXT("  [%llu] Phase=%d Elapsed=%.3f Dur=%.3f Delay=%.3f Loop=%d Paused=%d NextTick=%d Mode=%d"),
-            P.Key,
-            (int32)T.Phase,
-            T.PhaseElapsed,
-            T.Duration,
-            T.InitialDelay,
-            (int32)T.bLoop,
-            (int32)T.bPaused,
-            (int32)T.bNextTick,
-            (int32)T.DilationMode);
+    TArray<FEnhancedTimerMilestone> Milestones;
+    Milestones.Reserve(TimesRemaining.Num());
+    for (float TimeRemaining : TimesRemaining)
+    {
+        FEnhancedTimerMilestone& Milestone = Milestones.AddDefaulted_GetRef();
+        Milestone.TimeRemaining = TimeRemaining;
+        if (Event.IsBound())
+        {
+            Milestone.Callback.BindUFunction(Event.GetUObject(), Event.GetFunctionName());
+        }
+    }
+    SetTimerMilestones(Handle, MoveTemp(Milestones));
+}
+
+int32 UEnhancedTimerManagerSubsystem::GetNumTimerMilestones(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const TArray<FEnhancedTimerMilestone>* Milestones = TimerMilestones.Find(Handle.Id);
+    return Milestones ? Milestones->Num() : 0;
+}
+
+void UEnhancedTimerManagerSubsystem::GetTimerForecast(float BucketSeconds, int32 NumBuckets, TArray<int32>& OutCounts) const
+{
+    OutCounts.Reset(NumBuckets);
+    OutCounts.AddZeroed(FMath::Max(0, NumBuckets));
+
+    const UWorld* World      = GetWorld();
+    const bool    bPausedNow = IsGamePaused();
+
+    TArray<int32> GroupCounts;
+    FReadScopeLock _(MapLock);
+    for (const FTimerGroup& Group : Groups)
+    {
+        if (Group.Timers.IsEmpty()) continue;
+
+        Group.Timers.Forecast(BucketSeconds, NumBuckets, World, bPausedNow, GroupCounts);
+        for (int32 i = 0; i < GroupCounts.Num(); ++i)
+        {
+            OutCounts[i] += GroupCounts[i];
+        }
+    }
+}
+
+// ===== Interval ticks =====
+
+FEnhancedIntervalTickHandle UEnhancedTimerManagerSubsystem::RegisterIntervalTick(float Interval,
+                                                                                FEnhancedIntervalTickDelegate Callback,
+                                                                                EEnhancedTimerTimeDilationMode DilationMode,
+                                                                                AActor* DilationActor,
+                                                                                bool bAffectedByGamePause)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Interval, Callback, DilationMode, DilationActor, bAffectedByGamePause]()
+        {
+            RegisterIntervalTick(Interval, Callback, DilationMode, DilationActor, bAffectedByGamePause);
+        });
+        return FEnhancedIntervalTickHandle();
+    }
+
+    return IntervalTicks.Register(Interval, MoveTemp(Callback), DilationMode, DilationActor, bAffectedByGamePause);
+}
+
+void UEnhancedTimerManagerSubsystem::UnregisterIntervalTick(FEnhancedIntervalTickHandle& Handle)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        const FEnhancedIntervalTickHandle Copy = Handle;
+        AsyncTask(ENamedThreads::GameThread, [this, Copy]() mutable { UnregisterIntervalTick(Copy); });
+        Handle.Invalidate();
+        return;
+    }
+
+    IntervalTicks.Unregister(Handle);
+    Handle.Invalidate();
+}
+
+// ===== Poll timers =====
+
+FEnhancedPollHandle UEnhancedTimerManagerSubsystem::SetPollTimer(FEnhancedPollPredicate Predicate,
+                                                                 FEnhancedPollFinishedDelegate OnFinished,
+                                                                 const FEnhancedPollSettings& Settings,
+                                                                 EEnhancedTimerTimeDilationMode DilationMode,
+                                                                 AActor* DilationActor,
+                                                                 bool bAffectedByGamePause)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Predicate, OnFinished, Settings, DilationMode, DilationActor, bAffectedByGamePause]()
+        {
+            SetPollTimer(Predicate, OnFinished, Settings, DilationMode, DilationActor, bAffectedByGamePause);
+        });
+        return FEnhancedPollHandle();
+    }
+
+    if (!Predicate.IsBound()) return FEnhancedPollHandle();
+
+    return PollTimers.Register(MoveTemp(Predicate), MoveTemp(OnFinished), Settings, DilationMode, DilationActor, bAffectedByGamePause);
+}
+
+void UEnhancedTimerManagerSubsystem::ClearPollTimer(FEnhancedPollHandle& Handle)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        const FEnhancedPollHandle Copy = Handle;
+        AsyncTask(ENamedThreads::GameThread, [this, Copy]() mutable { ClearPollTimer(Copy); });
+        Handle.Invalidate();
+        return;
+    }
+
+    PollTimers.Unregister(Handle);
+    Handle.Invalidate();
+}
+
+// ===== Deferred release =====
+
+void UEnhancedTimerManagerSubsystem::DestroyActorAfter(AActor* Actor, float Seconds)
+{
+    ReleaseObjectAfter(Actor, Seconds, FEnhancedDeferredRelease::DestroyAction);
+}
+
+uint16 UEnhancedTimerManagerSubsystem::RegisterDeferredReleaseAction(FEnhancedDeferredReleaseDelegate Action)
+{
+    check(IsInGameThread());   // the id is needed by the caller
+    return DeferredRelease.RegisterAction(MoveTemp(Action));
+}
+
+void UEnhancedTimerManagerSubsystem::ReleaseObjectAfter(UObject* Object, float Seconds, uint16 Action)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        TWeakObjectPtr<UObject> WeakObject = Object;
+        AsyncTask(ENamedThreads::GameThread, [this, WeakObject, Seconds, Action]()
+        {
+            ReleaseObjectAfter(WeakObject.Get(), Seconds, Action);
+        });
+        return;
+    }
+
+    DeferredRelease.ReleaseAfter(Object, Seconds, Action);
+}
+
+bool UEnhancedTimerManagerSubsystem::CancelDeferredRelease(UObject* Object)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        TWeakObjectPtr<UObject> WeakObject = Object;
+        AsyncTask(ENamedThreads::GameThread, [this, WeakObject]() { CancelDeferredRelease(WeakObject.Get()); });
+        return false;
+    }
+
+    return DeferredRelease.Cancel(Object);
+}
+
+float UEnhancedTimerManagerSubsystem::GetDeferredReleaseTimeLeft(UObject* Object) const
+{
+    return DeferredRelease.GetTimeLeft(Object);
+}
+
+// ===== Bulk operations =====
+
+void UEnhancedTimerManagerSubsystem::InvalidateTimers(TConstArrayView<FEnhancedTimerHandle> Handles)
+{
+    TArray<uint64, TInlineAllocator<16>> Ids;
+    Ids.Reserve(Handles.Num());
+    for (const FEnhancedTimerHandle& Handle : Handles)
+    {
+        if (Handle.Id != 0 && Handle.Owner.Get() == this)
+        {
+            Ids.Add(Handle.Id);
+        }
+    }
+    InvalidateTimerIds(Ids);
+}
+
+void UEnhancedTimerManagerSubsystem::InvalidateTimerIds(TConstArrayView<uint64> Ids)
+{
+    if (Ids.Num() == 0) return;
+
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        TArray<uint64> Copy(Ids.GetData(), Ids.Num());
+        AsyncTask(ENamedThreads::GameThread, [this, Copy = MoveTemp(Copy)]() { InvalidateTimerIds(Copy); });
+        return;
+    }
+
+    FWriteScopeLock _(MapLock);
+    for (uint64 Id : Ids)
+    {
+        if (GroupIndexFromId(Id) < NumTickGroups)
+        {
+            Groups[GroupIndexFromId(Id)].Timers.Remove(Id);
+        }
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::InvalidateAllTimers()
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this]() { InvalidateAllTimers(); });
+        return;
+    }
+
+    FWriteScopeLock _(MapLock);
+    for (FTimerGroup& Group : Groups)
+    {
+        Group.Timers.Empty();
+    }
+    TimerTags.Reset();
+    TagIndex.Reset();
+    RetryStates.Reset();
+    TimerMilestones.Reset();
+}
+
+void UEnhancedTimerManagerSubsystem::PauseAllTimers()
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this]() { PauseAllTimers(); });
+        return;
+    }
+
+    FWriteScopeLock _(MapLock);
+    for (FTimerGroup& Group : Groups)
+    {
+        Group.Timers.SetAllPaused(true);
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::UnpauseAllTimers()
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this]() { UnpauseAllTimers(); });
+        return;
+    }
+
+    FWriteScopeLock _(MapLock);
+    for (FTimerGroup& Group : Groups)
+    {
+        Group.Timers.SetAllPaused(false);
+    }
+}
+
+// ===== Gameplay tags =====
+
+void UEnhancedTimerManagerSubsystem::SetTimerTags(const FEnhancedTimerHandle& Handle, const FGameplayTagContainer& Tags)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Tags]() { SetTimerTags(Handle, Tags); });
+        return;
+    }
+
+    FWriteScopeLock _(MapLock);
+    if (!FindTimer(Handle.Id)) return;
+
+    UnindexTimerTags(Handle.Id);
+    if (Tags.IsEmpty()) return;
+
+    // Index every tag together with its parents, so a query for A.B also finds timers tagged A.B.C.
+    const FGameplayTagContainer Expanded = Tags.GetGameplayTagParents();
+    for (const FGameplayTag& Tag : Expanded)
+    {
+        TagIndex.FindOrAdd(Tag).Add(Handle.Id);
+    }
+    TimerTags.Add(Handle.Id, Tags);
+}
+
+FGameplayTagContainer UEnhancedTimerManagerSubsystem::GetTimerTags(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FGameplayTagContainer* Tags = TimerTags.Find(Handle.Id);
+    return Tags ? *Tags : FGameplayTagContainer();
+}
+
+void UEnhancedTimerManagerSubsystem::UnindexTimerTags(uint64 Id)
+{
+    FGameplayTagContainer Tags;
+    if (!TimerTags.RemoveAndCopyValue(Id, Tags)) return;
+
+    const FGameplayTagContainer Expanded = Tags.GetGameplayTagParents();
+    for (const FGameplayTag& Tag : Expanded)
+    {
+        if (TSet<uint64>* Ids = TagIndex.Find(Tag))
+        {
+            Ids->Remove(Id);
+            if (Ids->Num() == 0)
+            {
+                TagIndex.Remove(Tag);
+            }
+        }
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::CollectTimersWithTag(const FGameplayTag& Tag, TArray<uint64>& OutIds) const
+{
+    OutIds.Reset();
+    if (const TSet<uint64>* Ids = Tag.IsValid() ? TagIndex.Find(Tag) : nullptr)
+    {
+        OutIds.Reserve(Ids->Num());
+        for (uint64 Id : *Ids)
+        {
+            OutIds.Add(Id);
+        }
+    }
+}
+
+int32 UEnhancedTimerManagerSubsystem::GetNumTimersWithTag(FGameplayTag Tag) const
+{
+    FReadScopeLock _(MapLock);
+    const TSet<uint64>* Ids = Tag.IsValid() ? TagIndex.Find(Tag) : nullptr;
+    if (!Ids) return 0;
+
+    int32 NumValid = 0;
+    for (uint64 Id : *Ids)
+    {
+        const FEnhancedTimerData* T = FindTimer(Id);
+        NumValid += (T && !T->IsCancelled()) ? 1 : 0;
+    }
+    return NumValid;
+}
+
+void UEnhancedTimerManagerSubsystem::GetTimersWithTag(FGameplayTag Tag, TArray<FEnhancedTimerHandle>& OutHandles) const
+{
+    OutHandles.Reset();
+
+    FReadScopeLock _(MapLock);
+    const TSet<uint64>* Ids = Tag.IsValid() ? TagIndex.Find(Tag) : nullptr;
+    if (!Ids) return;
+
+    for (uint64 Id : *Ids)
+    {
+        const FEnhancedTimerData* T = FindTimer(Id);
+        if (T && !T->IsCancelled())
+        {
+            OutHandles.Emplace(Id, const_cast<UEnhancedTimerManagerSubsystem*>(this));
+        }
+    }
+}
+
+int32 UEnhancedTimerManagerSubsystem::PauseTimersWithTag(FGameplayTag Tag)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Tag]() { PauseTimersWithTag(Tag); });
+        return 0;
+    }
+
+    FWriteScopeLock _(MapLock);
+    CollectTimersWithTag(Tag, ReusableTagQuery);
+    for (uint64 Id : ReusableTagQuery)
+    {
+        Groups[GroupIndexFromId(Id)].Timers.SetPaused(Id, true);
+    }
+    return ReusableTagQuery.Num();
+}
+
+int32 UEnhancedTimerManagerSubsystem::UnpauseTimersWithTag(FGameplayTag Tag)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Tag]() { UnpauseTimersWithTag(Tag); });
+        return 0;
+    }
+
+    FWriteScopeLock _(MapLock);
+    CollectTimersWithTag(Tag, ReusableTagQuery);
+    for (uint64 Id : ReusableTagQuery)
+    {
+        Groups[GroupIndexFromId(Id)].Timers.SetPaused(Id, false);
+    }
+    return ReusableTagQuery.Num();
+}
+
+int32 UEnhancedTimerManagerSubsystem::InvalidateTimersWithTag(FGameplayTag Tag)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Tag]() { InvalidateTimersWithTag(Tag); });
+        return 0;
+    }
+
+    // Ids are collected first: removing a timer updates the index being queried.
+    FWriteScopeLock _(MapLock);
+    CollectTimersWithTag(Tag, ReusableTagQuery);
+    for (uint64 Id : ReusableTagQuery)
+    {
+        Groups[GroupIndexFromId(Id)].Timers.Remove(Id);
+    }
+    return ReusableTagQuery.Num();
+}
+
+int32 UEnhancedTimerManagerSubsystem::SetTimeScaleForTimersWithTag(FGameplayTag Tag, float TimeScale)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Tag, TimeScale]() { SetTimeScaleForTimersWithTag(Tag, TimeScale); });
+        return 0;
+    }
+
+    FWriteScopeLock _(MapLock);
+    CollectTimersWithTag(Tag, ReusableTagQuery);
+    for (uint64 Id : ReusableTagQuery)
+    {
+        Groups[GroupIndexFromId(Id)].Timers.SetTimeScale(Id, TimeScale);
+    }
+    return ReusableTagQuery.Num();
+}
+
+// ===== Tick groups =====
+
+void UEnhancedTimerManagerSubsystem::RequestGroupTick(EEnhancedTimerTickGroup Group)
+{
+    FEnhancedTimerTickFunction& TickFn = GroupTickFunctions[(int32)Group];
+    if (TickFn.bRequested) return;
+    TickFn.bRequested = true;
+
+    UWorld* World = TickFunctionsWorld.Get();
+    if (!World) World = GetWorld();
+    if (World && World->PersistentLevel && !TickFn.IsTickFunctionRegistered())
+    {
+        TickFn.RegisterTickFunction(World->PersistentLevel);
+        TickFunctionsWorld = World;
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::RegisterGroupTickFunctions(UWorld* World)
+{
+    UnregisterGroupTickFunctions();
+    if (!World || !World->PersistentLevel) return;
+
+    TickFunctionsWorld = World;
+    for (int32 i = 1; i < NumTickGroups; ++i)
+    {
+        FEnhancedTimerTickFunction& TickFn = GroupTickFunctions[i];
+        if (TickFn.bRequested)
+        {
+            TickFn.RegisterTickFunction(World->PersistentLevel);
+        }
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::UnregisterGroupTickFunctions()
+{
+    for (int32 i = 1; i < NumTickGroups; ++i)
+    {
+        FEnhancedTimerTickFunction& TickFn = GroupTickFunctions[i];
+        if (TickFn.IsTickFunctionRegistered())
+        {
+            TickFn.UnRegisterTickFunction();
+        }
+    }
+    TickFunctionsWorld.Reset();
+}
+
+void UEnhancedTimerManagerSubsystem::HandleWorldCleanup(UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+{
+    if (World && World == TickFunctionsWorld.Get())
+    {
+        UnregisterGroupTickFunctions();
+    }
+    if (World && ReplicationProxy.IsValid() && ReplicationProxy->GetWorld() == World)
+    {
+        ReplicationProxy.Reset();
+    }
+    if (World && World == PhysicsClockWorld.Get())
+    {
+        ReleasePhysicsClock();
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::AddTickGroupPrerequisite(EEnhancedTimerTickGroup Group, UObject* TargetObject, FTickFunction& TargetTickFunction)
+{
+    if (Group == EEnhancedTimerTickGroup::Default || Group == EEnhancedTimerTickGroup::Num) return;
+    GroupTickFunctions[(int32)Group].AddPrerequisite(TargetObject, TargetTickFunction);
+}
+
+void UEnhancedTimerManagerSubsystem::RemoveTickGroupPrerequisite(EEnhancedTimerTickGroup Group, UObject* TargetObject, FTickFunction& TargetTickFunction)
+{
+    if (Group == EEnhancedTimerTickGroup::Default || Group == EEnhancedTimerTickGroup::Num) return;
+    GroupTickFunctions[(int32)Group].RemovePrerequisite(TargetObject, TargetTickFunction);
+}
+
+void UEnhancedTimerManagerSubsystem::AddTickGroupDependent(EEnhancedTimerTickGroup Group, FTickFunction& DependentTickFunction)
+{
+    if (Group == EEnhancedTimerTickGroup::Default || Group == EEnhancedTimerTickGroup::Num) return;
+    DependentTickFunction.AddPrerequisite(this, GroupTickFunctions[(int32)Group]);
+}
+
+void UEnhancedTimerManagerSubsystem::RemoveTickGroupDependent(EEnhancedTimerTickGroup Group, FTickFunction& DependentTickFunction)
+{
+    if (Group == EEnhancedTimerTickGroup::Default || Group == EEnhancedTimerTickGroup::Num) return;
+    DependentTickFunction.RemovePrerequisite(this, GroupTickFunctions[(int32)Group]);
+}
+
+void UEnhancedTimerManagerSubsystem::AddTickGroupPrerequisiteActor(EEnhancedTimerTickGroup Group, AActor* PrerequisiteActor)
+{
+    if (PrerequisiteActor)
+    {
+        AddTickGroupPrerequisite(Group, PrerequisiteActor, PrerequisiteActor->PrimaryActorTick);
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::AddTickGroupDependentActor(EEnhancedTimerTickGroup Group, AActor* DependentActor)
+{
+    if (DependentActor)
+    {
+        AddTickGroupDependent(Group, DependentActor->PrimaryActorTick);
+    }
+}
+
+// ===== Retry timers =====
+
+FEnhancedTimerHandle UEnhancedTimerManagerSubsystem::SetRetryTimer(const FEnhancedRetryPolicy& Policy,
+                                                                   FEnhancedRetryAttemptDelegate Attempt,
+                                                                   FEnhancedRetryFinishedDelegate OnFinished,
+                                                                   EEnhancedTimerTimeDilationMode DilationMode,
+                                                                   AActor* DilationActor,
+                                                                   bool bAffectedByGamePause,
+                                                                   EEnhancedTimerTickGroup TickGroup)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Policy, Attempt, OnFinished, DilationMode, DilationActor, bAffectedByGamePause, TickGroup]()
+        {
+            SetRetryTimer(Policy, Attempt, OnFinished, DilationMode, DilationActor, bAffectedByGamePause, TickGroup);
+        });
+        return FEnhancedTimerHandle();
+    }
+
+    FRetryState State;
+    State.Policy     = Policy;
+    State.Attempt    = MoveTemp(Attempt);
+    State.OnFinished = MoveTemp(OnFinished);
+    State.Stream.Initialize(Policy.Seed);
+    State.NextDelay  = Policy.GetDelay(1, State.Stream);
+
+    // Looping entry: RunRetryAttempt sets the next delay as Duration before the loop re-arms.
+    FEnhancedTimerData Data;
+    Data.DilationMode         = DilationMode;
+    Data.DilationActor        = DilationActor;
+    Data.bAffectedByGamePause = bAffectedByGamePause;
+    Data.Arm(State.NextDelay, true);
+
+    const uint64 Id = AddTimer(MoveTemp(Data), TickGroup);
+    {
+        FWriteScopeLock _(MapLock);
+        if (FEnhancedTimerData* T = const_cast<FEnhancedTimerData*>(FindTimer(Id)))
+        {
+            T->Callback.Delegate = FTimerDelegate::CreateUObject(this, &UEnhancedTimerManagerSubsystem::RunRetryAttempt, Id);
+        }
+        RetryStates.Add(Id, MoveTemp(State));
+    }
+    return FEnhancedTimerHandle(Id, this);
+}
+
+void UEnhancedTimerManagerSubsystem::RunRetryAttempt(uint64 Id)
+{
+    FEnhancedRetryAttemptDelegate Attempt;
+    int32 AttemptNumber = 0;
+    {
+        FWriteScopeLock _(MapLock);
+        FRetryState* State = RetryStates.Find(Id);
+        if (!State) return;
+
+        AttemptNumber = ++State->Attempts;
+        Attempt       = State->Attempt;
+    }
+
+    const bool bSucceeded = Attempt.IsBound() && Attempt.Execute(AttemptNumber);
+
+    FEnhancedRetryFinishedDelegate OnFinished;
+    {
+        FWriteScopeLock _(MapLock);
+        FRetryState* State = RetryStates.Find(Id);
+        if (!State) return;    // stopped from the attempt
+
+        const bool bOutOfAttempts = State->Policy.MaxAttempts > 0 && State->Attempts >= State->Policy.MaxAttempts;
+        if (!bSucceeded && !bOutOfAttempts)
+        {
+            // The entry is between fire and re-arm: the loop restarts with the new period right after this callback.
+            State->NextDelay = State->Policy.GetDelay(State->Attempts + 1, State->Stream);
+            Groups[GroupIndexFromId(Id)].Timers.SetLoopDuration(Id, State->NextDelay);
+            return;
+        }
+
+        OnFinished = MoveTemp(State->OnFinished);
+        Groups[GroupIndexFromId(Id)].Timers.Remove(Id);   // also drops the retry state
+    }
+
+    OnFinished.ExecuteIfBound(bSucceeded, AttemptNumber);
+}
+
+int32 UEnhancedTimerManagerSubsystem::GetRetryAttemptCount(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FRetryState* State = RetryStates.Find(Handle.Id);
+    return State ? State->Attempts : -1;
+}
+
+float UEnhancedTimerManagerSubsystem::GetRetryNextDelay(const FEnhancedTimerHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FRetryState* State = RetryStates.Find(Handle.Id);
+    return State ? State->NextDelay : -1.f;
+}
+
+// ===== Rate limiters =====
+
+FEnhancedRateLimiterHandle UEnhancedTimerManagerSubsystem::CreateRateLimiter(float Capacity,
+                                                                             float RefillPerSecond,
+                                                                             EEnhancedTimerTimeDilationMode DilationMode,
+                                                                             AActor* DilationActor,
+                                                                             bool bAffectedByGamePause)
+{
+    FWriteScopeLock _(MapLock);
+    FEnhancedTimerSet& Clocks = Groups[(int32)EEnhancedTimerTickGroup::Default].Timers;
+
+    FRateLimiter Limiter;
+    Limiter.ClockIndex           = Clocks.AcquireClock(DilationMode, DilationActor, bAffectedByGamePause);
+    Limiter.DilationMode         = DilationMode;
+    Limiter.DilationActor        = DilationActor;
+    Limiter.bAffectedByGamePause = bAffectedByGamePause;
+    Limiter.Bucket.Init(Capacity, RefillPerSecond, Clocks.GetClockTime(Limiter.ClockIndex));
+
+    FEnhancedRateLimiterHandle Handle;
+    RateLimiters.Add(MoveTemp(Limiter), 0, Handle.Id);
+    return Handle;
+}
+
+void UEnhancedTimerManagerSubsystem::DestroyRateLimiter(FEnhancedRateLimiterHandle& Handle)
+{
+    {
+        FWriteScopeLock _(MapLock);
+        if (FRateLimiter* Limiter = RateLimiters.Find(Handle.Id))
+        {
+            FEnhancedTimerSet& Clocks = Groups[(int32)EEnhancedTimerTickGroup::Default].Timers;
+            Clocks.Remove(Limiter->WaitTimerId);
+            Clocks.ReleaseClock(Limiter->ClockIndex);
+            RateLimiters.Remove(Handle.Id);
+        }
+    }
+    Handle.Invalidate();
+}
+
+bool UEnhancedTimerManagerSubsystem::TryConsumeRateLimiter(const FEnhancedRateLimiterHandle& Handle, float Amount)
+{
+    FWriteScopeLock _(MapLock);
+    FRateLimiter* Limiter = RateLimiters.Find(Handle.Id);
+    if (!Limiter) return false;
+
+    const double Now = Groups[(int32)EEnhancedTimerTickGroup::Default].Timers.GetClockTime(Limiter->ClockIndex);
+    return Limiter->Bucket.TryConsume(Now, Amount);
+}
+
+float UEnhancedTimerManagerSubsystem::GetRateLimiterTokens(const FEnhancedRateLimiterHandle& Handle) const
+{
+    FReadScopeLock _(MapLock);
+    const FRateLimiter* Limiter = RateLimiters.Find(Handle.Id);
+    if (!Limiter) return -1.f;
+
+    return Limiter->Bucket.GetTokens(Groups[(int32)EEnhancedTimerTickGroup::Default].Timers.GetClockTime(Limiter->ClockIndex));
+}
+
+float UEnhancedTimerManagerSubsystem::GetRateLimiterTimeUntilAvailable(const FEnhancedRateLimiterHandle& Handle, float Amount) const
+{
+    FReadScopeLock _(MapLock);
+    const FRateLimiter* Limiter = RateLimiters.Find(Handle.Id);
+    if (!Limiter) return -1.f;
+
+    const double Now  = Groups[(int32)EEnhancedTimerTickGroup::Default].Timers.GetClockTime(Limiter->ClockIndex);
+    const float  Wait = Limiter->Bucket.GetTimeUntilAvailable(Now, Amount);
+    return Wait == MAX_flt ? -1.f : Wait;
+}
+
+void UEnhancedTimerManagerSubsystem::NotifyWhenRateLimiterAvailable(const FEnhancedRateLimiterHandle& Handle, float Amount, const FTimerDelegate& Callback)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Amount, Callback]() { NotifyWhenRateLimiterAvailable(Handle, Amount, Callback); });
+        return;
+    }
+
+    FEnhancedTimerData Data;
+    float Wait = 0.f;
+    {
+        FWriteScopeLock _(MapLock);
+        FRateLimiter* Limiter = RateLimiters.Find(Handle.Id);
+        if (!Limiter) return;
+
+        FEnhancedTimerSet& Clocks = Groups[(int32)EEnhancedTimerTickGroup::Default].Timers;
+        Clocks.Remove(Limiter->WaitTimerId);
+        Limiter->WaitTimerId = 0;
+
+        Wait = Limiter->Bucket.GetTimeUntilAvailable(Clocks.GetClockTime(Limiter->ClockIndex), Amount);
+        if (Wait == MAX_flt) return;    // never (Amount above capacity or no refill)
+
+        // Same dilation and pause settings as the limiter: the timer runs on the limiter's clock.
+        Data.DilationMode         = Limiter->DilationMode;
+        Data.DilationActor        = Limiter->DilationActor;
+        Data.bAffectedByGamePause = Limiter->bAffectedByGamePause;
+    }
+
+    if (Wait <= 0.f)
+    {
+        Callback.ExecuteIfBound();
+        return;
+    }
+
+    const uint64 LimiterId = Handle.Id;
+    Data.Callback.Delegate = FTimerDelegate::CreateWeakLambda(this, [this, LimiterId, Callback]()
+    {
+        {
+            FWriteScopeLock _(MapLock);
+            if (FRateLimiter* Limiter = RateLimiters.Find(LimiterId))
+            {
+                Limiter->WaitTimerId = 0;
+            }
+        }
+        Callback.ExecuteIfBound();
+    });
+    Data.Arm(Wait, false);
+
+    const uint64 TimerId = AddTimer(MoveTemp(Data), EEnhancedTimerTickGroup::Default);
+
+    FWriteScopeLock _(MapLock);
+    if (FRateLimiter* Limiter = RateLimiters.Find(LimiterId))
+    {
+        Limiter->WaitTimerId = TimerId;
+    }
+}
+
+int32 UEnhancedTimerManagerSubsystem::GetNumRateLimiters() const
+{
+    FReadScopeLock _(MapLock);
+    return RateLimiters.Num();
+}
+
+// ===== Physics-domain timers =====
+
+FEnhancedPhysicsTimerClock* UEnhancedTimerManagerSubsystem::GetOrCreatePhysicsClock()
+{
+    check(IsInGameThread());
+
+    UWorld* World = GetWorld();
+    if (PhysicsClock && PhysicsClockWorld.Get() == World)
+    {
+        return PhysicsClock;
+    }
+
+    ReleasePhysicsClock();
+    PhysicsClock = FEnhancedPhysicsTimerClock::RegisterWithWorld(World);
+    if (PhysicsClock)
+    {
+        PhysicsClockWorld = World;
+    }
+    return PhysicsClock;
+}
+
+void UEnhancedTimerManagerSubsystem::ReleasePhysicsClock()
+{
+    if (PhysicsClock)
+    {
+        FEnhancedPhysicsTimerClock::UnregisterFromWorld(PhysicsClockWorld.Get(), PhysicsClock);
+    }
+    PhysicsClock = nullptr;
+    PhysicsClockWorld.Reset();
+    PublishedPhysicsTime.store(0.0, std::memory_order_relaxed);
+}
+
+void UEnhancedTimerManagerSubsystem::DrainPhysicsCommands()
+{
+    FPhysicsCommand Cmd;
+    while (PhysicsCommands.Dequeue(Cmd))
+    {
+        switch (Cmd.Type)
+        {
+            case FPhysicsCommand::EType::Add:
+                if (FEnhancedPhysicsTimerClock* Clock = GetOrCreatePhysicsClock())
+                {
+                    Clock->Add(Cmd.Handle, Cmd.Duration, Cmd.bLoop, MoveTemp(Cmd.Callback));
+                }
+                break;
+            case FPhysicsCommand::EType::Cancel:
+                if (PhysicsClock) PhysicsClock->Cancel(Cmd.Handle);
+                break;
+            case FPhysicsCommand::EType::CancelAll:
+                if (PhysicsClock) PhysicsClock->CancelAll();
+                break;
+        }
+    }
+    PublishedPhysicsTime.store(PhysicsClock ? PhysicsClock->GetTime() : 0.0, std::memory_order_relaxed);
+}
+
+FEnhancedPhysicsTimerHandle UEnhancedTimerManagerSubsystem::SetPhysicsTimer(FEnhancedPhysicsTimerClock::FCallback&& Callback, float Duration, bool bLoop)
+{
+    if (!IsInGameThread())
+    {
+        FPhysicsCommand Cmd;
+        Cmd.Type     = FPhysicsCommand::EType::Add;
+        Cmd.Handle   = FEnhancedPhysicsTimerClock::AllocateHandle();
+        Cmd.Duration = Duration;
+        Cmd.bLoop    = bLoop;
+        Cmd.Callback = MoveTemp(Callback);
+
+        const FEnhancedPhysicsTimerHandle Handle = Cmd.Handle;
+        PhysicsCommands.Enqueue(MoveTemp(Cmd));
+        return Handle;
+    }
+
+    // Keep the order of earlier off-thread commands.
+    DrainPhysicsCommands();
+    FEnhancedPhysicsTimerClock* Clock = GetOrCreatePhysicsClock();
+    return Clock ? Clock->Add(Duration, bLoop, MoveTemp(Callback)) : FEnhancedPhysicsTimerHandle();
+}
+
+void UEnhancedTimerManagerSubsystem::CancelPhysicsTimer(const FEnhancedPhysicsTimerHandle& Handle)
+{
+    if (!IsInGameThread())
+    {
+        FPhysicsCommand Cmd;
+        Cmd.Type   = FPhysicsCommand::EType::Cancel;
+        Cmd.Handle = Handle;
+        PhysicsCommands.Enqueue(MoveTemp(Cmd));
+        return;
+    }
+
+    DrainPhysicsCommands();
+    if (PhysicsClock)
+    {
+        PhysicsClock->Cancel(Handle);
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::CancelAllPhysicsTimers()
+{
+    if (!IsInGameThread())
+    {
+        FPhysicsCommand Cmd;
+        Cmd.Type = FPhysicsCommand::EType::CancelAll;
+        PhysicsCommands.Enqueue(MoveTemp(Cmd));
+        return;
+    }
+
+    DrainPhysicsCommands();
+    if (PhysicsClock)
+    {
+        PhysicsClock->CancelAll();
+    }
+}
+
+double UEnhancedTimerManagerSubsystem::GetPhysicsClockTime() const
+{
+    if (!IsInGameThread())
+    {
+        return PublishedPhysicsTime.load(std::memory_order_relaxed);
+    }
+    return PhysicsClock ? PhysicsClock->GetTime() : 0.0;
+}
+
+// ===== Replication =====
+
+void UEnhancedTimerManagerSubsystem::RegisterReplicationProxy(AEnhancedTimerReplicationProxy* Proxy)
+{
+    if (Proxy && Proxy->GetWorld() == GetWorld())
+    {
+        ReplicationProxy = Proxy;
+    }
+}
+
+void UEnhancedTimerManagerSubsystem::UnregisterReplicationProxy(AEnhancedTimerReplicationProxy* Proxy)
+{
+    if (ReplicationProxy.Get() == Proxy)
+    {
+        ReplicationProxy.Reset();
+    }
+}
+
+AEnhancedTimerReplicationProxy* UEnhancedTimerManagerSubsystem::GetOrSpawnReplicationProxy()
+{
+    if (AEnhancedTimerReplicationProxy* Existing = ReplicationProxy.Get())
+    {
+        return Existing;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client) return nullptr;
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    Params.ObjectFlags |= RF_Transient;
+    AEnhancedTimerReplicationProxy* Proxy = World->SpawnActor<AEnhancedTimerReplicationProxy>(Params);
+    ReplicationProxy = Proxy;
+    return Proxy;
+}
+
+bool UEnhancedTimerManagerSubsystem::SetTimerReplicated(const FEnhancedTimerHandle& Handle, FName Key)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Handle, Key]() { SetTimerReplicated(Handle, Key); });
+        return false;
+    }
+
+    const UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogEnhancedTimerManager, Warning, TEXT("SetTimerReplicated(%s) ignored: only the server can replicate timers."), *Key.ToString());
+        return false;
+    }
+    if (Key.IsNone() || !IsTimerValid(Handle)) return false;
+
+    AEnhancedTimerReplicationProxy* Proxy = GetOrSpawnReplicationProxy();
+    if (!Proxy) return false;
+
+    // Re-using a key moves it to the new timer.
+    TArray<FEnhancedReplicatedTimerEntry>& Entries = Proxy->GetMutableEntries();
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        if (Entries[i].Key == Key || Entries[i].TimerId == Handle.Id)
+        {
+            Proxy->RemoveEntryAt(i);
+        }
+    }
+
+    Proxy->AddEntry(Key, Handle.Id);
+    UpdateReplicatedTimers(GetWorld());
+    return true;
+}
+
+void UEnhancedTimerManagerSubsystem::StopReplicatingTimer(FName Key)
+{
+    EnforceGameThread();
+    if (!IsInGameThread())
+    {
+        AsyncTask(ENamedThreads::GameThread, [this, Key]() { StopReplicatingTimer(Key); });
+        return;
+    }
+
+    AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    if (!Proxy || Proxy->GetNetMode() == NM_Client) return;
+
+    TArray<FEnhancedReplicatedTimerEntry>& Entries = Proxy->GetMutableEntries();
+    const int32 Index = Entries.IndexOfByPredicate([Key](const FEnhancedReplicatedTimerEntry& E) { return E.Key == Key; });
+    Proxy->RemoveEntryAt(Index);
+}
+
+void UEnhancedTimerManagerSubsystem::UpdateReplicatedTimers(UWorld* World)
+{
+    AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    if (!Proxy || !World) return;
+
+    TArray<FEnhancedReplicatedTimerEntry>& Entries = Proxy->GetMutableEntries();
+    if (Entries.Num() == 0) return;
+
+    const double ServerNow  = Proxy->GetServerTime();
+    const bool   bPausedNow = IsGamePaused();
+
+    FReadScopeLock _(MapLock);
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        FEnhancedReplicatedTimerEntry& Entry = Entries[i];
+        const FEnhancedTimerData* T = FindTimer(Entry.TimerId);
+        if (!T || T->IsCancelled())
+        {
+            // Timer finished or was invalidated: clients get PreReplicatedRemove.
+            Proxy->RemoveEntryAt(i);
+            continue;
+        }
+
+        // Time until the next fire, including any remaining initial delay.
+        const float TimeUntilFire = FindSet(Entry.TimerId)->GetTimeUntilFire(*T);
+
+        // Timer seconds per server world second (the world delta already carries global dilation; includes TimeScale).
+        const bool  bFrozen = T->bPaused || (bPausedNow && !T->bAffectedByGamePause);
+        const float Scale   = FMath::Max(KINDA_SMALL_NUMBER, T->GetEffectiveDelta(1.f, World));
+        const double NewEnd = ServerNow + (double)(TimeUntilFire / Scale);
+
+        bool bDirty = Entry.ReplicationID == INDEX_NONE    // added by SetTimerReplicated, never marked
+                   || Entry.bPaused != bFrozen
+                   || Entry.bLoop != T->bLoop
+                   || !FMath::IsNearlyEqual(Entry.Duration, T->Duration)
+                   || !FMath::IsNearlyEqual(Entry.TimeScale, Scale, 1.e-3f);
+
+        if (bFrozen)
+        {
+            bDirty |= FMath::Abs(Entry.RemainingWhenPaused - TimeUntilFire) > ReplicationTolerance;
+        }
+        else
+        {
+            bDirty |= FMath::Abs(Entry.EndServerTime - NewEnd) > (double)ReplicationTolerance;
+        }
+
+        if (!bDirty) continue;
+
+        Entry.bPaused             = bFrozen;
+        Entry.bLoop               = T->bLoop;
+        Entry.Duration            = T->Duration;
+        Entry.TimeScale           = Scale;
+        Entry.RemainingWhenPaused = TimeUntilFire;
+        Entry.EndServerTime       = NewEnd;
+        Proxy->MarkEntryDirty(Entry);
+    }
+}
+
+float UEnhancedTimerManagerSubsystem::GetReplicatedTimerTimeLeft(FName Key) const
+{
+    const AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    const FEnhancedReplicatedTimerEntry* Entry = Proxy ? Proxy->FindEntry(Key) : nullptr;
+    return Entry ? Entry->GetTimeLeft(Proxy->GetServerTime()) : -1.f;
+}
+
+bool UEnhancedTimerManagerSubsystem::IsReplicatedTimerActive(FName Key) const
+{
+    const AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    return Proxy && Proxy->FindEntry(Key) != nullptr;
+}
+
+bool UEnhancedTimerManagerSubsystem::IsReplicatedTimerPaused(FName Key) const
+{
+    const AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    const FEnhancedReplicatedTimerEntry* Entry = Proxy ? Proxy->FindEntry(Key) : nullptr;
+    return Entry ? Entry->bPaused : false;
+}
+
+float UEnhancedTimerManagerSubsystem::GetReplicatedTimerDuration(FName Key) const
+{
+    const AEnhancedTimerReplicationProxy* Proxy = ReplicationProxy.Get();
+    const FEnhancedReplicatedTimerEntry* Entry = Proxy ? Proxy->FindEntry(Key) : nullptr;
+    return Entry ? Entry->Duration : -1.f;
+}
+
+#if WITH_EDITOR || UE_BUILD_DEVELOPMENT
+void UEnhancedTimerManagerSubsystem::DumpActiveTimers() const
+{
+    FReadScopeLock RLock(MapLock);
+    int32 NumTimers = 0;
+    for (const FTimerGroup& Group : Groups)
+    {
+        NumTimers += Group.Timers.Num();
+    }
+    UE_LOG(LogEnhancedTimerManager, Log, TEXT("Active timers: %d, LastTick=%.3f ms, Processed=%d"),
+        NumTimers, LastTickTimeMs, TimersProcessedLastTick);
+
+    for (const FTimerGroup& Group : Groups)
+    {
+        Group.Timers.ForEach([&Group](const FEnhancedTimerData& T)
+        {
+            UE_LOG(LogEnhancedTimerManager, Log, TEXT("  [%llu] Group=%d Prio=%d Phase=%d Elapsed=%.3f Dur=%.3f Delay=%.3f Scale=%.3f Loop=%d Paused=%d NextTick=%d Mode=%d"),
+                T.Id,
+                GroupIndexFromId(T.Id),
+                T.Priority,
+                (int32)T.Phase,
+                Group.Timers.GetPhaseElapsed(T),
+                T.Duration,
+                T.InitialDelay,
+                T.TimeScale,
+                (int32)T.bLoop,
+                (int32)T.bPaused,
+                (int32)T.bNextTick,
+                (int32)T.DilationMode);
+        });
+
+        const int32 GroupIndex = (int32)(&Group - Groups);
+        Group.Timers.ForEachDomain([GroupIndex](const FEnhancedTimerDomain& Domain)
+        {
+            UE_LOG(LogEnhancedTimerManager, Log, TEXT("  Domain Group=%d Mode=%d Time=%.3f Timers=%d Engine=%s Short=%.0f%% Churn=%.0f/s"),
+                GroupIndex,
+                (int32)Domain.Key.DilationMode,
+                Domain.Time,
+                Domain.NumTimers,
+                LexToString(Domain.Engine),
+                Domain.Workload.ShortFraction * 100.f,
+                Domain.Workload.ChurnPerSecond);
+        });
     }
 }
 #endif
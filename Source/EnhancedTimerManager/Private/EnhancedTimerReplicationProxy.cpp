@@ -0,0 +1,187 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerReplicationProxy.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "HAL/IConsoleManager.h"
+
+// ===== FEnhancedReplicatedTimerEntry (client callbacks) =====
+
+void FEnhancedReplicatedTimerEntry::PostReplicatedAdd(const FEnhancedReplicatedTimerArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->NotifyEntryChanged(*this, false);
+}
+
+void FEnhancedReplicatedTimerEntry::PostReplicatedChange(const FEnhancedReplicatedTimerArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->NotifyEntryChanged(*this, false);
+}
+
+void FEnhancedReplicatedTimerEntry::PreReplicatedRemove(const FEnhancedReplicatedTimerArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->NotifyEntryChanged(*this, true);
+}
+
+// ===== AEnhancedTimerReplicationProxy =====
+
+AEnhancedTimerReplicationProxy::AEnhancedTimerReplicationProxy()
+{
+	bReplicates      = true;
+	bAlwaysRelevant  = true;
+	bNetLoadOnClient = false;
+	SetReplicatingMovement(false);
+
+	// Entries only change on pause/scale/re-arm; no need to consider the actor every frame.
+	SetNetUpdateFrequency(10.f);
+	SetMinNetUpdateFrequency(1.f);
+
+	ReplicatedTimers.Owner = this;
+}
+
+void AEnhancedTimerReplicationProxy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AEnhancedTimerReplicationProxy, ReplicatedTimers);
+}
+
+void AEnhancedTimerReplicationProxy::BeginPlay()
+{
+	Super::BeginPlay();
+	ReplicatedTimers.Owner = this;
+
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UEnhancedTimerManagerSubsystem* Sub = GI->GetSubsystem<UEnhancedTimerManagerSubsystem>())
+		{
+			Sub->RegisterReplicationProxy(this);
+		}
+	}
+}
+
+void AEnhancedTimerReplicationProxy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UEnhancedTimerManagerSubsystem* Sub = GI->GetSubsystem<UEnhancedTimerManagerSubsystem>())
+		{
+			Sub->UnregisterReplicationProxy(this);
+		}
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+double AEnhancedTimerReplicationProxy::GetServerTime() const
+{
+	const UWorld* World = GetWorld();
+	if (!World) return 0.0;
+
+	if (const AGameStateBase* GS = World->GetGameState())
+	{
+		return GS->GetServerWorldTimeSeconds();
+	}
+	return World->GetTimeSeconds();
+}
+
+const FEnhancedReplicatedTimerEntry* AEnhancedTimerReplicationProxy::FindEntry(FName Key) const
+{
+	return ReplicatedTimers.Items.FindByPredicate([Key](const FEnhancedReplicatedTimerEntry& E) { return E.Key == Key; });
+}
+
+FEnhancedReplicatedTimerEntry* AEnhancedTimerReplicationProxy::FindEntryByTimerId(uint64 TimerId)
+{
+	return ReplicatedTimers.Items.FindByPredicate([TimerId](const FEnhancedReplicatedTimerEntry& E) { return E.TimerId == TimerId; });
+}
+
+FEnhancedReplicatedTimerEntry& AEnhancedTimerReplicationProxy::AddEntry(FName Key, uint64 TimerId)
+{
+	FEnhancedReplicatedTimerEntry& Entry = ReplicatedTimers.Items.AddDefaulted_GetRef();
+	Entry.Key     = Key;
+	Entry.TimerId = TimerId;
+	return Entry;
+}
+
+void AEnhancedTimerReplicationProxy::RemoveEntryAt(int32 Index)
+{
+	if (!ReplicatedTimers.Items.IsValidIndex(Index)) return;
+	ReplicatedTimers.Items.RemoveAtSwap(Index);
+	ReplicatedTimers.MarkArrayDirty();
+	++NumEntryUpdates;
+}
+
+void AEnhancedTimerReplicationProxy::NotifyEntryChanged(const FEnhancedReplicatedTimerEntry& Entry, bool bRemoved)
+{
+	++NumEntryUpdates;
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UEnhancedTimerManagerSubsystem* Sub = GI->GetSubsystem<UEnhancedTimerManagerSubsystem>())
+		{
+			if (bRemoved)
+			{
+				Sub->OnReplicatedTimerRemoved.Broadcast(Entry.Key);
+			}
+			else
+			{
+				Sub->OnReplicatedTimerUpdated.Broadcast(Entry.Key);
+			}
+		}
+	}
+}
+
+// ===== Debug =====
+
+#if !UE_BUILD_SHIPPING
+
+namespace EnhancedTimerReplicationDebug
+{
+	static const TCHAR* GetNetModeName(ENetMode NetMode)
+	{
+		switch (NetMode)
+		{
+			case NM_DedicatedServer: return TEXT("DedicatedServer");
+			case NM_ListenServer:    return TEXT("ListenServer");
+			case NM_Client:          return TEXT("Client");
+			default:                 return TEXT("Standalone");
+		}
+	}
+
+	/**
+	 * Log every replicated timer as seen by each game world of the process. In a PIE listen-server session the
+	 * server and its clients run in one process, so the client-side time left is printed next to the server's.
+	 */
+	static void Compare()
+	{
+		if (!GEngine) return;
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (!World || !World->IsGameWorld()) continue;
+
+			for (TActorIterator<AEnhancedTimerReplicationProxy> It(World); It; ++It)
+			{
+				const AEnhancedTimerReplicationProxy* Proxy = *It;
+				const double ServerTime = Proxy->GetServerTime();
+				UE_LOG(LogEnhancedTimerManager, Log, TEXT("%s (%s): server time %.3f, %d entries, %d entry updates"),
+					*World->GetName(), GetNetModeName(World->GetNetMode()), ServerTime, Proxy->GetEntries().Num(), Proxy->GetNumEntryUpdates());
+
+				for (const FEnhancedReplicatedTimerEntry& Entry : Proxy->GetEntries())
+				{
+					UE_LOG(LogEnhancedTimerManager, Log, TEXT("    %s: time left %.3f (end %.3f, scale %.2f, paused %d)"),
+						*Entry.Key.ToString(), Entry.GetTimeLeft(ServerTime), Entry.EndServerTime, Entry.TimeScale, (int32)Entry.bPaused);
+				}
+			}
+		}
+	}
+}
+
+static FAutoConsoleCommand CmdEnhancedTimersReplicationCompare(
+	TEXT("EnhancedTimers.Replication.Compare"),
+	TEXT("Log the time left of every replicated timer in each game world of the process (PIE: listen server and clients side by side)."),
+	FConsoleCommandDelegate::CreateStatic(&EnhancedTimerReplicationDebug::Compare));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,125 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerScope.h"
+#include "EnhancedTimerManagerSubsystem.h"
+
+FEnhancedTimerScope::FEnhancedTimerScope(UEnhancedTimerManagerSubsystem* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+}
+
+FEnhancedTimerScope::~FEnhancedTimerScope()
+{
+	Reset();
+}
+
+FEnhancedTimerScope::FEnhancedTimerScope(FEnhancedTimerScope&& Other)
+	: Subsystem(MoveTemp(Other.Subsystem))
+	, TimerIds(MoveTemp(Other.TimerIds))
+{
+	Other.Subsystem.Reset();
+	Other.TimerIds.Reset();
+}
+
+FEnhancedTimerScope& FEnhancedTimerScope::operator=(FEnhancedTimerScope&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		Subsystem = MoveTemp(Other.Subsystem);
+		TimerIds  = MoveTemp(Other.TimerIds);
+		Other.Subsystem.Reset();
+		Other.TimerIds.Reset();
+	}
+	return *this;
+}
+
+void FEnhancedTimerScope::SetSubsystem(UEnhancedTimerManagerSubsystem* InSubsystem)
+{
+	if (Subsystem.Get() == InSubsystem) return;
+	Reset();
+	Subsystem = InSubsystem;
+}
+
+FEnhancedTimerHandle FEnhancedTimerScope::SetEnhancedTimer(const FTimerDelegate& InDelegate,
+                                                           float Duration,
+                                                           EEnhancedTimerTimeDilationMode DilationMode,
+                                                           AActor* DilationActor,
+                                                           bool bAffectedByGamePause,
+                                                           bool bLoop,
+                                                           float DelayToStartCountingDown,
+                                                           float DelayToStartCountingDownVariation,
+                                                           EEnhancedTimerTickGroup TickGroup)
+{
+	UEnhancedTimerManagerSubsystem* Sub = Subsystem.Get();
+	if (!Sub) return FEnhancedTimerHandle();
+
+	const FEnhancedTimerHandle Handle = Sub->SetEnhancedTimer(InDelegate, Duration, DilationMode, DilationActor,
+	                                                          bAffectedByGamePause, bLoop,
+	                                                          DelayToStartCountingDown, DelayToStartCountingDownVariation, TickGroup);
+	Track(Handle);
+	return Handle;
+}
+
+FEnhancedTimerHandle FEnhancedTimerScope::SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate,
+                                                                             EEnhancedTimerTickGroup TickGroup)
+{
+	UEnhancedTimerManagerSubsystem* Sub = Subsystem.Get();
+	if (!Sub) return FEnhancedTimerHandle();
+
+	const FEnhancedTimerHandle Handle = Sub->SetEnhancedTimerExecutedInNextTick(InDelegate, TickGroup);
+	Track(Handle);
+	return Handle;
+}
+
+void FEnhancedTimerScope::Add(const FEnhancedTimerHandle& Handle)
+{
+	if (!Subsystem.IsValid() && Handle.HasOwner())
+	{
+		Subsystem = Handle.Owner;
+	}
+	if (Handle.Owner != Subsystem || Handle.Id == 0) return;
+	TimerIds.AddUnique(Handle.Id);
+}
+
+void FEnhancedTimerScope::Release(const FEnhancedTimerHandle& Handle)
+{
+	if (Handle.Owner != Subsystem) return;
+	TimerIds.RemoveSingleSwap(Handle.Id, EAllowShrinking::No);
+}
+
+void FEnhancedTimerScope::Reset()
+{
+	if (TimerIds.Num() == 0) return;
+
+	if (UEnhancedTimerManagerSubsystem* Sub = Subsystem.Get())
+	{
+		Sub->InvalidateTimerIds(TimerIds);
+	}
+	TimerIds.Reset();
+}
+
+void FEnhancedTimerScope::Compact()
+{
+	UEnhancedTimerManagerSubsystem* Sub = Subsystem.Get();
+	if (!Sub)
+	{
+		TimerIds.Reset();
+		return;
+	}
+
+	for (int32 i = TimerIds.Num() - 1; i >= 0; --i)
+	{
+		if (!Sub->IsTimerValid(FEnhancedTimerHandle(TimerIds[i], Sub)))
+		{
+			TimerIds.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void FEnhancedTimerScope::Track(const FEnhancedTimerHandle& Handle)
+{
+	// Off-thread creation returns an invalid handle; nothing to own in that case.
+	if (Handle.Id == 0) return;
+	TimerIds.Add(Handle.Id);
+}
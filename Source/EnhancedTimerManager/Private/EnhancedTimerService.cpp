@@ -0,0 +1,85 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerService.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarEnhancedTimersSharedService(
+	TEXT("EnhancedTimers.SharedService"),
+	false,
+	TEXT("Host the timers of every game instance in one process-wide service that advances them in parallel.\n")
+	TEXT("Read when a game instance starts."),
+	ECVF_Default);
+
+bool FEnhancedTimerService::IsEnabled()
+{
+	return CVarEnhancedTimersSharedService.GetValueOnGameThread();
+}
+
+FEnhancedTimerService& FEnhancedTimerService::Get()
+{
+	static FEnhancedTimerService Service;
+	return Service;
+}
+
+void FEnhancedTimerService::Register(UEnhancedTimerManagerSubsystem* Subsystem)
+{
+	check(IsInGameThread());
+	if (!Subsystem) return;
+
+	Partitions.AddUnique(Subsystem);
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEnhancedTimerService::Tick));
+	}
+}
+
+void FEnhancedTimerService::Unregister(UEnhancedTimerManagerSubsystem* Subsystem)
+{
+	check(IsInGameThread());
+
+	Partitions.RemoveSingleSwap(Subsystem);
+	ActivePartitions.RemoveSingleSwap(Subsystem);
+	if (Partitions.Num() == 0 && TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FEnhancedTimerService::Tick(float /*DeltaTime*/)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_EnhancedTimerService_Tick);
+
+	// Game thread: capture per-partition inputs (dilation rates, pause state, delta) and skip idle instances.
+	ActivePartitions.Reset();
+	for (int32 Index = Partitions.Num() - 1; Index >= 0; --Index)
+	{
+		UEnhancedTimerManagerSubsystem* Subsystem = Partitions[Index].Get();
+		if (!ensureMsgf(Subsystem, TEXT("A timer subsystem was destroyed without leaving the shared service.")))
+		{
+			Partitions.RemoveAtSwap(Index);
+			continue;
+		}
+		if (Subsystem->BeginSharedAdvance())
+		{
+			ActivePartitions.Add(Subsystem);
+		}
+	}
+	if (Partitions.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	// Workers: each partition advances only its own set under its own lock and touches no UObject. Timer
+	// callbacks run on the Game Thread in the subsystem tick; so do the index updates of timers the advance
+	// dropped (the subsystem queues them).
+	ParallelFor(ActivePartitions.Num(), [this](int32 Index)
+	{
+		ActivePartitions[Index]->RunSharedAdvance();
+	});
+
+	return true;
+}
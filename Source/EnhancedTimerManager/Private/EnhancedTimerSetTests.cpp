@@ -0,0 +1,172 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerSet.h"
+#include "EnhancedTokenBucket.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EnhancedTimerSetTests
+{
+	using FTestSet = TEnhancedTimerSet<TFunction<void()>>;
+
+	static constexpr int32 NumTargets = 12;
+
+	// Two deadlines within the tested frame and two priorities, so every tie-break level is exercised.
+	static float GetTargetDuration(int32 Label) { return Label % 3 == 0 ? 0.5f : 1.f; }
+	static int32 GetTargetPriority(int32 Label) { return Label % 4 == 1 ? 5 : 0; }
+
+	static void AddTarget(FTestSet& Timers, int32 Label, TArray<int32>& OutOrder)
+	{
+		FTestSet::FTimer Timer;
+		Timer.Callback = [Label, &OutOrder]() { OutOrder.Add(Label); };
+		Timer.Priority = GetTargetPriority(Label);
+		Timer.Arm(GetTargetDuration(Label), false);
+		Timers.Emplace(MoveTemp(Timer));
+	}
+
+	/** Fire order of the targets after an insert/remove history (0 = fresh set; 1, 2 = targets reuse freed slots). */
+	static TArray<int32> RunHistory(int32 History, EEnhancedTimerEngine Engine)
+	{
+		FTestSet Timers;
+		FEnhancedTimerEngineSettings Settings;
+		Settings.bAdaptive    = false;
+		Settings.ForcedEngine = Engine;
+		Timers.SetEngineSettings(Settings);
+
+		TArray<int32>  Order;
+		TArray<uint64> Fillers;
+		auto AddFillers = [&Timers, &Fillers](int32 Num)
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Fillers.Add(Timers.Add([]() {}, 100.f));
+			}
+		};
+
+		switch (History)
+		{
+			case 1:
+			{
+				// Freed slots, released in creation order.
+				AddFillers(64);
+				for (uint64 Id : Fillers)
+				{
+					Timers.Remove(Id);
+				}
+				for (int32 Label = 0; Label < NumTargets; ++Label)
+				{
+					AddTarget(Timers, Label, Order);
+				}
+				break;
+			}
+			case 2:
+			{
+				// Freed slots in scrambled order, and more slots freed between the targets.
+				AddFillers(64);
+				for (int32 i = 1; i < Fillers.Num(); i += 2)
+				{
+					Timers.Remove(Fillers[i]);
+				}
+				for (int32 i = Fillers.Num() - 2; i >= 0; i -= 2)
+				{
+					Timers.Remove(Fillers[i]);
+				}
+				Fillers.Reset();
+
+				for (int32 Label = 0; Label < NumTargets / 2; ++Label)
+				{
+					AddTarget(Timers, Label, Order);
+				}
+				AddFillers(16);
+				for (int32 i = Fillers.Num() - 1; i >= 0; --i)
+				{
+					Timers.Remove(Fillers[i]);
+				}
+				for (int32 Label = NumTargets / 2; Label < NumTargets; ++Label)
+				{
+					AddTarget(Timers, Label, Order);
+				}
+				break;
+			}
+			default:
+			{
+				for (int32 Label = 0; Label < NumTargets; ++Label)
+				{
+					AddTarget(Timers, Label, Order);
+				}
+				break;
+			}
+		}
+
+		Timers.Tick(1.f);
+		return Order;
+	}
+
+	static FString ToString(const TArray<int32>& Order)
+	{
+		return FString::JoinBy(Order, TEXT(","), [](int32 Label) { return FString::FromInt(Label); });
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnhancedTimerSetFireOrderTest, "EnhancedTimers.TimerSet.FireOrder",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FEnhancedTimerSetFireOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace EnhancedTimerSetTests;
+
+	// Deadline first, then higher priority, then creation order.
+	TArray<int32> Expected;
+	for (int32 Label = 0; Label < NumTargets; ++Label)
+	{
+		Expected.Add(Label);
+	}
+	Expected.StableSort([](int32 A, int32 B)
+	{
+		if (GetTargetDuration(A) != GetTargetDuration(B)) return GetTargetDuration(A) < GetTargetDuration(B);
+		return GetTargetPriority(A) > GetTargetPriority(B);
+	});
+
+	for (EEnhancedTimerEngine Engine : { EEnhancedTimerEngine::Heap, EEnhancedTimerEngine::Scan, EEnhancedTimerEngine::Wheel })
+	{
+		for (int32 History = 0; History < 3; ++History)
+		{
+			TestEqual(FString::Printf(TEXT("Fire order (%s engine, history %d)"), LexToString(Engine), History),
+				ToString(RunHistory(History, Engine)), ToString(Expected));
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnhancedTimerSetHeldClockTest, "EnhancedTimers.TimerSet.HeldClock",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FEnhancedTimerSetHeldClockTest::RunTest(const FString& Parameters)
+{
+	// A set with no timers but a held clock (a rate limiter) must still be advanced, also by the shared service,
+	// which skips sets that report no active domains.
+	EnhancedTimerSetTests::FTestSet Timers;
+	TestFalse(TEXT("Empty set is idle"), Timers.HasActiveDomains());
+
+	const int32 Clock = Timers.AcquireClock(EEnhancedTimerTimeDilationMode::IgnoreTimeDilation, nullptr, false);
+	TestTrue(TEXT("Set without timers stays active while a clock is held"), Timers.IsEmpty() && Timers.HasActiveDomains());
+
+	FEnhancedTokenBucket Bucket;
+	Bucket.Init(2.f, 1.f, Timers.GetClockTime(Clock));
+	TestTrue(TEXT("First token"), Bucket.TryConsume(Timers.GetClockTime(Clock)));
+	TestTrue(TEXT("Second token"), Bucket.TryConsume(Timers.GetClockTime(Clock)));
+	TestFalse(TEXT("Bucket drained"), Bucket.TryConsume(Timers.GetClockTime(Clock)));
+
+	TArray<FEnhancedFiredTimer> Fired;
+	Timers.Advance(1.5f, nullptr, false, Fired);
+	TestEqual(TEXT("Held clock advanced"), Timers.GetClockTime(Clock), 1.5);
+	TestTrue(TEXT("Bucket refilled from the held clock"), Bucket.TryConsume(Timers.GetClockTime(Clock)));
+
+	Timers.ReleaseClock(Clock);
+	Timers.Advance(0.f, nullptr, false, Fired);
+	TestFalse(TEXT("Released clock is collected"), Timers.HasActiveDomains());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
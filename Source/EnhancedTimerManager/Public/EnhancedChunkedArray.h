@@ -0,0 +1,141 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * Array of trivially copyable elements stored in fixed-size chunks that are never moved or reallocated.
+ *
+ * Growing allocates one more chunk instead of doubling and copying the whole array, so the cost of an append
+ * stays flat; only the small table of chunk pointers is ever copied. Chunks are kept on Reset and reused.
+ * Offers the subset of the TArray and TArray heap API the timer engines need (min-heap on operator<).
+ */
+template<typename ElementType, int32 ChunkSize = 1024>
+class TEnhancedChunkedArray
+{
+	static_assert(TIsTriviallyCopyConstructible<ElementType>::Value, "TEnhancedChunkedArray only holds trivially copyable elements");
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+public:
+	FORCEINLINE int32 Num() const { return Count; }
+
+	FORCEINLINE ElementType& operator[](int32 Index)
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		return Chunks[Index / ChunkSize][Index % ChunkSize];
+	}
+
+	FORCEINLINE const ElementType& operator[](int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < Count);
+		return Chunks[Index / ChunkSize][Index % ChunkSize];
+	}
+
+	void Add(const ElementType& Element)
+	{
+		if (Count == Chunks.Num() * ChunkSize)
+		{
+			Chunks.Add(MakeUnique<ElementType[]>(ChunkSize));
+		}
+		(*this)[Count++] = Element;
+	}
+
+	void RemoveAtSwap(int32 Index, EAllowShrinking /*AllowShrinking*/ = EAllowShrinking::No)
+	{
+		(*this)[Index] = (*this)[Count - 1];
+		--Count;
+	}
+
+	/** Drop every element; the chunks stay allocated. */
+	void Reset() { Count = 0; }
+
+	/** Drop every element and free the chunks. */
+	void Empty()
+	{
+		Count = 0;
+		Chunks.Empty();
+	}
+
+	// ===== Min-heap (same layout as the TArray heap functions) =====
+
+	void HeapPush(const ElementType& Element)
+	{
+		Add(Element);
+		SiftUp(Count - 1);
+	}
+
+	FORCEINLINE const ElementType& HeapTop() const { return (*this)[0]; }
+
+	void HeapPop(ElementType& OutElement, EAllowShrinking /*AllowShrinking*/ = EAllowShrinking::No)
+	{
+		OutElement = (*this)[0];
+		(*this)[0] = (*this)[Count - 1];
+		--Count;
+		if (Count > 1)
+		{
+			SiftDown(0);
+		}
+	}
+
+	// ===== Iteration (array order) =====
+
+	template<bool bConst>
+	class TIterator
+	{
+		using ArrayType = std::conditional_t<bConst, const TEnhancedChunkedArray, TEnhancedChunkedArray>;
+		using RefType   = std::conditional_t<bConst, const ElementType&, ElementType&>;
+
+	public:
+		TIterator(ArrayType& InArray, int32 InIndex) : Array(InArray), Index(InIndex) {}
+
+		FORCEINLINE RefType operator*() const { return Array[Index]; }
+		FORCEINLINE TIterator& operator++() { ++Index; return *this; }
+		FORCEINLINE bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+
+	private:
+		ArrayType& Array;
+		int32      Index;
+	};
+
+	TIterator<false> begin()       { return TIterator<false>(*this, 0); }
+	TIterator<false> end()         { return TIterator<false>(*this, Count); }
+	TIterator<true>  begin() const { return TIterator<true>(*this, 0); }
+	TIterator<true>  end() const   { return TIterator<true>(*this, Count); }
+
+private:
+	void SiftUp(int32 Index)
+	{
+		const ElementType Element = (*this)[Index];
+		while (Index > 0)
+		{
+			const int32 Parent = (Index - 1) / 2;
+			if (!(Element < (*this)[Parent])) break;
+			(*this)[Index] = (*this)[Parent];
+			Index = Parent;
+		}
+		(*this)[Index] = Element;
+	}
+
+	void SiftDown(int32 Index)
+	{
+		const ElementType Element = (*this)[Index];
+		for (;;)
+		{
+			int32 Child = Index * 2 + 1;
+			if (Child >= Count) break;
+			if (Child + 1 < Count && (*this)[Child + 1] < (*this)[Child])
+			{
+				++Child;
+			}
+			if (!((*this)[Child] < Element)) break;
+			(*this)[Index] = (*this)[Child];
+			Index = Child;
+		}
+		(*this)[Index] = Element;
+	}
+
+	TArray<TUniquePtr<ElementType[]>> Chunks;
+	int32                             Count = 0;
+};
@@ -0,0 +1,75 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UWorld;
+
+/** Custom release action (e.g. return to a pool). Receives the object whose deadline passed. */
+DECLARE_DELEGATE_OneParam(FEnhancedDeferredReleaseDelegate, UObject* /*Object*/);
+
+/**
+ * Batched "destroy / release after N seconds" for many objects (replacement for AActor::SetLifeSpan and
+ * per-object engine timers). Every pending release is a 24-byte (deadline, object, action) heap entry; the
+ * actions themselves (destroy, or delegates registered once, e.g. by a pool) are stored separately.
+ *
+ * Deadlines run on game time (global time dilation, stopped while the game is paused). Due entries are
+ * processed in one pass per frame, at most MaxPerFrame of them (0 = no cap) so that mass expiry does not
+ * turn into a destruction spike; the rest follow in the next frames in deadline order.
+ *
+ * Not thread-safe; owned and ticked by UEnhancedTimerManagerSubsystem on the Game Thread.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedDeferredRelease
+{
+public:
+	/** Built-in action: AActor::Destroy (other objects are ignored). */
+	static constexpr uint16 DestroyAction = 0;
+
+	/** Register a custom action and return its id for ReleaseAfter. */
+	uint16 RegisterAction(FEnhancedDeferredReleaseDelegate&& Action);
+
+	/** Run Action on Object after Seconds of game time. Replaces a pending release of the same object. */
+	void ReleaseAfter(UObject* Object, float Seconds, uint16 Action = DestroyAction);
+
+	/** Returns true if a release was pending. */
+	bool Cancel(const UObject* Object);
+
+	bool IsPending(const UObject* Object) const { return Object && Pending.Contains(FObjectKey(Object)); }
+
+	/** Seconds until the pending release of Object, or -1. */
+	float GetTimeLeft(const UObject* Object) const;
+
+	int32 Num() const { return Pending.Num(); }
+
+	void Reset();
+
+	/** Advance the clock and run due releases (at most MaxPerFrame, 0 = all). Returns the number of actions run. */
+	int32 Tick(float DeltaTime, const UWorld* World, bool bGamePaused, int32 MaxPerFrame);
+
+private:
+	struct FEntry
+	{
+		double     Deadline = 0.0;
+		FObjectKey Object;
+		uint32     Serial = 0;    // matches Pending while the entry is current
+		uint16     Action = DestroyAction;
+
+		bool operator<(const FEntry& Other) const { return Deadline < Other.Deadline; }
+	};
+
+	struct FPendingRelease
+	{
+		double Deadline = 0.0;
+		uint32 Serial = 0;
+	};
+
+	void RunAction(UObject* Object, uint16 Action);
+
+	TArray<FEntry>                           Heap;      // min-heap on Deadline, lazy deletion
+	TMap<FObjectKey, FPendingRelease>        Pending;
+	TArray<FEnhancedDeferredReleaseDelegate> Actions;   // index = action id - 1
+	double                                   Time = 0.0;
+	uint32                                   NextSerial = 1;
+};
@@ -0,0 +1,215 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnhancedTimerSet.h"
+
+/** Batch of a TEnhancedDomainBatches: a dilation domain, optionally split further by the owner (e.g. per interval). */
+struct FEnhancedBatchKey
+{
+	FEnhancedTimerDomainKey Domain;
+	int32                   SubKey = 0;
+
+	bool operator==(const FEnhancedBatchKey& Other) const { return SubKey == Other.SubKey && Domain == Other.Domain; }
+	friend uint32 GetTypeHash(const FEnhancedBatchKey& Key) { return HashCombine(GetTypeHash(Key.Domain), ::GetTypeHash(Key.SubKey)); }
+};
+
+/**
+ * Many small recurring entries, grouped in batches that each have one clock, instead of a timer each.
+ * Interval ticks and poll timers are built on it.
+ *
+ * Every batch advances with one dilation lookup per frame. Its due times are a dense array parallel to the
+ * entries, scanned in one tight pass; only the due entries are then handed to the owner. Entries never move
+ * while a batch is processed: adds and removals made from callbacks are applied after the pass.
+ *
+ * EntryType needs a uint64 Id (assigned by Add) and double Start(double BatchTime), which returns the first due
+ * time once the entry joins its batch. Not thread-safe; Game Thread only.
+ */
+template<typename EntryType>
+class TEnhancedDomainBatches
+{
+public:
+	/** Add Entry to the batch of Key and return its Id (never 0). Safe to call during Tick. */
+	uint64 Add(const FEnhancedBatchKey& Key, EntryType&& Entry)
+	{
+		Entry.Id = NextId++;
+		const uint64 Id = Entry.Id;
+		if (bTicking)
+		{
+			PendingAdds.Add({ Key, MoveTemp(Entry) });
+		}
+		else
+		{
+			AddNow(Key, MoveTemp(Entry));
+		}
+		return Id;
+	}
+
+	/**
+	 * Remove an entry. During Tick the entry stays in place until the pass ends; Disarm is called on it so
+	 * that it does nothing more (e.g. unbind its delegates). Returns true if the entry existed.
+	 */
+	template<typename DisarmType>
+	bool Remove(uint64 Id, DisarmType&& Disarm)
+	{
+		const int32 PendingIndex = PendingAdds.IndexOfByPredicate([Id](const FPendingAdd& Add) { return Add.Entry.Id == Id; });
+		if (PendingIndex != INDEX_NONE)
+		{
+			PendingAdds.RemoveAtSwap(PendingIndex);
+			return true;
+		}
+
+		const FLocation* Location = Locations.Find(Id);
+		if (!Location) return false;
+
+		if (bTicking)
+		{
+			Disarm(Batches[Location->Batch].Entries[Location->Index]);
+			PendingRemovals.Add(Id);
+		}
+		else
+		{
+			RemoveNow(Id);
+		}
+		return true;
+	}
+
+	void Reset()
+	{
+		check(!bTicking);
+		Batches.Reset();
+		BatchLookup.Reset();
+		Locations.Reset();
+		PendingAdds.Reset();
+		PendingRemovals.Reset();
+	}
+
+	int32 Num() const { return Locations.Num() + PendingAdds.Num(); }
+	int32 NumBatches() const { return Batches.Num(); }
+
+	/**
+	 * Advance every batch clock and call OnDue(Entry, Now, NextDue) for each due entry, Now being the batch time.
+	 * OnDue sets the next due time through NextDue and returns false to remove the entry.
+	 */
+	template<typename FuncType>
+	void Tick(float DeltaTime, const UWorld* World, bool bGamePaused, FuncType&& OnDue)
+	{
+		check(!bTicking);
+		{
+			TGuardValue<bool> TickGuard(bTicking, true);
+
+			for (typename TSparseArray<FBatch>::TIterator It(Batches); It; ++It)
+			{
+				FBatch& Batch = *It;
+				if (Batch.Entries.Num() == 0)
+				{
+					BatchLookup.Remove(Batch.Key);
+					It.RemoveCurrent();
+					continue;
+				}
+				if (bGamePaused && !Batch.Key.Domain.bTicksWhenPaused) continue;
+
+				// One dilation lookup per batch and frame.
+				Batch.Time += DeltaTime * EnhancedTimers::GetDilationScale(Batch.Key.Domain.DilationMode, World, Batch.Key.Domain.Actor.Get());
+				const double Now = Batch.Time;
+
+				Due.Reset();
+				const double* NextDue = Batch.NextDue.GetData();
+				for (int32 i = 0, Num = Batch.NextDue.Num(); i < Num; ++i)
+				{
+					if (NextDue[i] <= Now)
+					{
+						Due.Add(i);
+					}
+				}
+
+				for (int32 Index : Due)
+				{
+					EntryType& Entry = Batch.Entries[Index];
+					if (!OnDue(Entry, Now, Batch.NextDue[Index]))
+					{
+						PendingRemovals.Add(Entry.Id);
+					}
+				}
+			}
+		}
+
+		for (uint64 Id : PendingRemovals)
+		{
+			RemoveNow(Id);
+		}
+		PendingRemovals.Reset();
+
+		for (FPendingAdd& Add : PendingAdds)
+		{
+			AddNow(Add.Key, MoveTemp(Add.Entry));
+		}
+		PendingAdds.Reset();
+	}
+
+private:
+	struct FBatch
+	{
+		FEnhancedBatchKey Key;
+		double            Time = 0.0;
+		TArray<double>    NextDue;     // hot: scanned every frame, parallel to Entries
+		TArray<EntryType> Entries;
+	};
+
+	struct FLocation
+	{
+		int32 Batch = INDEX_NONE;
+		int32 Index = INDEX_NONE;
+	};
+
+	struct FPendingAdd
+	{
+		FEnhancedBatchKey Key;
+		EntryType         Entry;
+	};
+
+	void AddNow(const FEnhancedBatchKey& Key, EntryType&& Entry)
+	{
+		int32 BatchIndex = INDEX_NONE;
+		if (const int32* Found = BatchLookup.Find(Key))
+		{
+			BatchIndex = *Found;
+		}
+		else
+		{
+			FBatch Batch;
+			Batch.Key  = Key;
+			BatchIndex = Batches.Add(MoveTemp(Batch));
+			BatchLookup.Add(Key, BatchIndex);
+		}
+
+		FBatch& Batch = Batches[BatchIndex];
+		Locations.Add(Entry.Id, { BatchIndex, Batch.Entries.Num() });
+		Batch.NextDue.Add(Entry.Start(Batch.Time));
+		Batch.Entries.Add(MoveTemp(Entry));
+	}
+
+	void RemoveNow(uint64 Id)
+	{
+		FLocation Location;
+		if (!Locations.RemoveAndCopyValue(Id, Location)) return;
+
+		FBatch& Batch = Batches[Location.Batch];
+		Batch.NextDue.RemoveAtSwap(Location.Index, 1, EAllowShrinking::No);
+		Batch.Entries.RemoveAtSwap(Location.Index, 1, EAllowShrinking::No);
+		if (Batch.Entries.IsValidIndex(Location.Index))
+		{
+			Locations[Batch.Entries[Location.Index].Id].Index = Location.Index;
+		}
+	}
+
+	TSparseArray<FBatch>           Batches;
+	TMap<FEnhancedBatchKey, int32> BatchLookup;
+	TMap<uint64, FLocation>        Locations;
+	TArray<FPendingAdd>            PendingAdds;       // added during Tick (merged afterwards so arrays do not move under callbacks)
+	TArray<uint64>                 PendingRemovals;   // removed, finished or unbound during Tick
+	TArray<int32>                  Due;               // reused by Tick
+	uint64                         NextId = 1;
+	bool                           bTicking = false;
+};
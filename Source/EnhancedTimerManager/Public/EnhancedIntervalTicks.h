@@ -0,0 +1,70 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnhancedDomainBatches.h"
+
+/** Called every interval with the domain time elapsed since the previous call. */
+DECLARE_DELEGATE_OneParam(FEnhancedIntervalTickDelegate, float /*DeltaTime*/);
+
+/** Identifies an interval tick registration. 0 == Invalid. */
+struct FEnhancedIntervalTickHandle
+{
+	uint64 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+
+	bool operator==(const FEnhancedIntervalTickHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FEnhancedIntervalTickHandle& Other) const { return Id != Other.Id; }
+};
+
+/**
+ * Low-rate ticks for many objects without a tick function each (replacement for PrimaryActorTick.TickInterval).
+ *
+ * Registrations with the same interval (1 ms resolution) and dilation domain share a batch (see
+ * TEnhancedDomainBatches). Each registration gets a random phase offset within the interval so that thousands
+ * of 0.25 s ticks spread over the frames instead of all landing on the same one.
+ * A registration whose delegate is no longer bound (owner destroyed) is dropped automatically.
+ *
+ * Not thread-safe; owned and ticked by UEnhancedTimerManagerSubsystem on the Game Thread.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedIntervalTicks
+{
+public:
+	FEnhancedIntervalTickHandle Register(float Interval,
+	                                     FEnhancedIntervalTickDelegate&& Callback,
+	                                     EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+	                                     AActor* DilationActor = nullptr,
+	                                     bool bAffectedByGamePause = false);
+
+	/** Returns true if the registration existed. Safe to call from an interval callback. */
+	bool Unregister(const FEnhancedIntervalTickHandle& Handle);
+
+	void Reset() { Entries.Reset(); }
+
+	int32 Num() const { return Entries.Num(); }
+	int32 NumBuckets() const { return Entries.NumBatches(); }
+
+	/** Advance every bucket clock and run the registrations that are due. Returns the number of callbacks run. */
+	int32 Tick(float DeltaTime, const UWorld* World, bool bGamePaused);
+
+private:
+	struct FEntry
+	{
+		uint64                        Id = 0;
+		FEnhancedIntervalTickDelegate Callback;
+		float                         Interval = 0.f;
+		double                        LastTime = 0.0;    // bucket time
+
+		double Start(double BatchTime)
+		{
+			// Random phase within the interval spreads registrations made in the same frame.
+			LastTime = BatchTime;
+			return BatchTime + FMath::FRand() * Interval;
+		}
+	};
+
+	TEnhancedDomainBatches<FEntry> Entries;   // one batch per (interval, domain)
+};
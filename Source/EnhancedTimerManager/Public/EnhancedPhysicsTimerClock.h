@@ -0,0 +1,117 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class UWorld;
+namespace Chaos { class ISimCallbackObject; }
+
+/** Identifies a timer on the physics-domain clock. 0 == Invalid. */
+struct FEnhancedPhysicsTimerHandle
+{
+	uint64 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+
+	bool operator==(const FEnhancedPhysicsTimerHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FEnhancedPhysicsTimerHandle& Other) const { return Id != Other.Id; }
+};
+
+/**
+ * Timer clock that advances inside the Chaos physics step (async physics substeps when enabled).
+ *
+ * Game-thread side: Add / Cancel / CancelAll only push commands onto a lock-free MPSC queue and can be called
+ * from any thread. Physics-thread side: Advance_Internal drains the queue, advances the clock by the substep
+ * delta and fires due timers in (deadline, creation) order.
+ *
+ * Callbacks run on the physics thread and receive the physics sim time of the firing substep; they must only
+ * touch physics-thread state (e.g. Chaos::FRigidBodyHandle_Internal) or hand results back through their own
+ * thread-safe channel.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedPhysicsTimerClock
+{
+public:
+	using FCallback = TUniqueFunction<void(double /*PhysicsTime*/)>;
+
+	FEnhancedPhysicsTimerClock() = default;
+	FEnhancedPhysicsTimerClock(const FEnhancedPhysicsTimerClock&) = delete;
+	FEnhancedPhysicsTimerClock& operator=(const FEnhancedPhysicsTimerClock&) = delete;
+
+	/**
+	 * Create a clock driven by the world's physics solver (pre-simulate callback of every (sub)step).
+	 * Returns nullptr if the world has no physics scene. Game thread only.
+	 */
+	static FEnhancedPhysicsTimerClock* RegisterWithWorld(UWorld* World);
+
+	/** Unregister a clock created by RegisterWithWorld. The physics thread frees it afterwards; do not use it again. */
+	static void UnregisterFromWorld(UWorld* World, FEnhancedPhysicsTimerClock* Clock);
+
+	// ===== Any thread =====
+
+	/** Schedule Callback to run Duration physics seconds after the command is consumed by the physics step. */
+	FEnhancedPhysicsTimerHandle Add(float Duration, bool bLoop, FCallback&& Callback);
+
+	/** Add with a handle from AllocateHandle (owners that hand out the handle before the clock receives the timer). */
+	void Add(const FEnhancedPhysicsTimerHandle& Handle, float Duration, bool bLoop, FCallback&& Callback);
+
+	/** Reserve a process-wide unique handle for a later Add. */
+	static FEnhancedPhysicsTimerHandle AllocateHandle();
+
+	void Cancel(const FEnhancedPhysicsTimerHandle& Handle);
+	void CancelAll();
+
+	/** Physics time published at the end of the last step. */
+	double GetTime() const { return PublishedTime.load(std::memory_order_acquire); }
+
+	/** Number of timers alive on the physics thread at the end of the last step. */
+	int32 GetNumActive() const { return PublishedNumActive.load(std::memory_order_acquire); }
+
+	// ===== Physics thread =====
+
+	/** Consume pending commands, advance by DeltaTime and fire due timers. */
+	void Advance_Internal(float DeltaTime);
+
+private:
+	struct FCommand
+	{
+		enum class EType : uint8 { Add, Cancel, CancelAll };
+
+		EType     Type = EType::Add;
+		uint64    Id = 0;
+		float     Duration = 0.f;
+		bool      bLoop = false;
+		FCallback Callback;
+	};
+
+	struct FTimer
+	{
+		uint64    Id = 0;
+		double    Deadline = 0.0;
+		float     Duration = 0.f;
+		bool      bLoop = false;
+		FCallback Callback;
+	};
+
+	void ProcessCommands_Internal();
+	void RemoveAt_Internal(int32 Index);
+
+	// Owning solver callback (game thread only, used to unregister)
+	Chaos::ISimCallbackObject* SimCallback = nullptr;
+
+	// Game thread -> physics thread
+	TQueue<FCommand, EQueueMode::Mpsc> Commands;
+
+	// Physics thread -> readers
+	std::atomic<double> PublishedTime{0.0};
+	std::atomic<int32>  PublishedNumActive{0};
+
+	// Physics thread only
+	double               Time = 0.0;
+	TArray<FTimer>       Timers;
+	TMap<uint64, int32>  IdToIndex;
+	TArray<int32>        DueScratch;
+};
@@ -0,0 +1,99 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnhancedDomainBatches.h"
+
+/** Cheap condition polled by a poll timer; return true once it holds. */
+DECLARE_DELEGATE_RetVal(bool, FEnhancedPollPredicate);
+
+/** A poll finished: the predicate became true, or the timeout ran out (bSatisfied == false). */
+DECLARE_DELEGATE_OneParam(FEnhancedPollFinishedDelegate, bool /*bSatisfied*/);
+
+/** Identifies a poll timer. 0 == Invalid. */
+struct FEnhancedPollHandle
+{
+	uint64 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+
+	bool operator==(const FEnhancedPollHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FEnhancedPollHandle& Other) const { return Id != Other.Id; }
+};
+
+/** Polling cadence: start fast, back off while the predicate keeps failing. */
+struct FEnhancedPollSettings
+{
+	float InitialInterval = 0.f;    // seconds before the second poll (0 = next frame)
+	float MinInterval = 1.f / 60.f; // floor of the interval once backing off
+	float MaxInterval = 0.5f;
+	float Backoff = 1.5f;           // interval multiplier after each failed poll
+	float Timeout = 0.f;            // 0 = poll until satisfied or cancelled
+};
+
+/**
+ * Poll timers ("wait until the asset is loaded", "until the player lands") without a looping timer each.
+ *
+ * Polls sharing a dilation domain form one batch (see TEnhancedDomainBatches); only the due polls run their
+ * predicate. Each failed poll multiplies its interval by Backoff (between MinInterval and MaxInterval), so long
+ * waits cost less and less. The finished callback runs once, after the batch scan, unless the poll is cancelled
+ * first. A poll whose predicate is no longer bound (owner destroyed) is dropped without a callback.
+ *
+ * Not thread-safe; owned and ticked by UEnhancedTimerManagerSubsystem on the Game Thread.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedPollTimers
+{
+public:
+	FEnhancedPollHandle Register(FEnhancedPollPredicate&& Predicate,
+	                             FEnhancedPollFinishedDelegate&& OnFinished,
+	                             const FEnhancedPollSettings& Settings,
+	                             EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+	                             AActor* DilationActor = nullptr,
+	                             bool bAffectedByGamePause = false);
+
+	/** Stop polling without calling OnFinished. Returns true if the poll existed. Safe to call from a predicate or callback. */
+	bool Unregister(const FEnhancedPollHandle& Handle);
+
+	void Reset();
+
+	int32 Num() const { return Polls.Num(); }
+
+	/** Advance the batch clocks, poll what is due and run finished callbacks. Returns the number of predicates evaluated. */
+	int32 Tick(float DeltaTime, const UWorld* World, bool bGamePaused);
+
+private:
+	struct FEntry
+	{
+		uint64                        Id = 0;
+		FEnhancedPollPredicate        Predicate;
+		FEnhancedPollFinishedDelegate OnFinished;
+		float                         Interval = 0.f;
+		float                         MinInterval = 0.f;
+		float                         MaxInterval = 0.f;
+		float                         Backoff = 1.f;
+		float                         Timeout = 0.f;
+		double                        Deadline = MAX_dbl;   // batch time of the timeout
+
+		double Start(double BatchTime)
+		{
+			if (Timeout > 0.f)
+			{
+				Deadline = BatchTime + Timeout;
+			}
+			return BatchTime;   // first poll on the next tick of the batch
+		}
+	};
+
+	struct FFinished
+	{
+		uint64                        Id = 0;
+		FEnhancedPollFinishedDelegate OnFinished;
+		bool                          bSatisfied = false;
+	};
+
+	TEnhancedDomainBatches<FEntry> Polls;          // one batch per domain
+	TArray<FFinished>              Finished;       // collected by the scan
+	TArray<FFinished>              FinishedToRun;  // swapped with Finished to run the callbacks (both reused)
+};
@@ -0,0 +1,34 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/** One attempt of a retry timer (1-based attempt number). Return true once the operation succeeded. */
+DECLARE_DELEGATE_RetVal_OneParam(bool, FEnhancedRetryAttemptDelegate, int32 /*Attempt*/);
+
+/** A retry sequence ended: it succeeded, or MaxAttempts attempts failed. */
+DECLARE_DELEGATE_TwoParams(FEnhancedRetryFinishedDelegate, bool /*bSucceeded*/, int32 /*Attempts*/);
+
+/** Exponential backoff with a cap and jitter from a seeded stream (same seed, same delays). */
+struct FEnhancedRetryPolicy
+{
+	float FirstDelay = 0.f;    // before attempt 1
+	float BaseDelay = 1.f;     // before attempt 2
+	float Multiplier = 2.f;    // growth per further attempt
+	float MaxDelay = 30.f;     // cap of every delay, jitter included
+	float Jitter = 0.1f;       // delay is scaled by a random factor in [1 - Jitter, 1 + Jitter]
+	int32 MaxAttempts = 5;     // 0 = retry until stopped
+	int32 Seed = 0;
+
+	/** Delay before attempt number Attempt (1-based); draws one value from Stream. */
+	float GetDelay(int32 Attempt, FRandomStream& Stream) const
+	{
+		const float JitterFactor = 1.f + Stream.FRandRange(-1.f, 1.f) * FMath::Clamp(Jitter, 0.f, 1.f);
+		if (Attempt <= 1) return FMath::Max(0.f, FirstDelay);
+
+		const float Exponential = BaseDelay * FMath::Pow(FMath::Max(1.f, Multiplier), (float)(Attempt - 2));
+		return FMath::Clamp(FMath::Min(Exponential, MaxDelay) * JitterFactor, 0.f, FMath::Max(0.f, MaxDelay));
+	}
+};
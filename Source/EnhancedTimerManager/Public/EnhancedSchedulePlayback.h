@@ -0,0 +1,124 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Engine/DataTable.h"
+#include "EnhancedTimerHandle.h"
+#include "EnhancedTimerManagerTypes.h"
+#include "EnhancedSchedulePlayback.generated.h"
+
+class UEnhancedTimerManagerSubsystem;
+
+/** One timed event of a precomputed schedule. Also usable as a DataTable row struct. */
+USTRUCT(BlueprintType)
+struct ENHANCEDTIMERMANAGER_API FEnhancedScheduleEvent : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	/** Seconds of playback time from Play(). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnhancedTimers")
+	float Time = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnhancedTimers")
+	FName Event;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnhancedTimers")
+	int32 IntValue = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnhancedTimers")
+	float FloatValue = 0.f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnhancedScheduleEvent, const FEnhancedScheduleEvent&, Event);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnhancedScheduleFinished);
+
+/**
+ * Plays a large time-sorted event schedule through the subsystem without creating all timers up front.
+ *
+ * Only a sliding window of the next WindowSize events exists as timers at any time; each fired event
+ * materializes the next one. Deadlines are measured against a playback clock timer in the same dilation
+ * domain, so the schedule follows time dilation and (game) pause exactly like normal timers and does not drift.
+ * An event whose time is already reached when it enters the window fires on the next tick of the subsystem;
+ * size the window so that it covers more than one frame worth of events.
+ *
+ * The playback must be referenced (UPROPERTY) by its owner while playing.
+ */
+UCLASS(BlueprintType)
+class ENHANCEDTIMERMANAGER_API UEnhancedSchedulePlayback : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Playback of the rows of Table (row struct FEnhancedScheduleEvent or derived). Rows are sorted by Time. */
+	UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Schedule", meta=(WorldContext="WorldContextObject"))
+	static UEnhancedSchedulePlayback* CreateFromDataTable(UObject* WorldContextObject, UDataTable* Table,
+		EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation,
+		AActor* DilationActor = nullptr, bool bAffectedByGamePause = false, int32 WindowSize = 32);
+
+	/** Playback of CSV lines "Time,Event[,IntValue[,FloatValue]]" (optional header line). Returns null on parse errors. */
+	UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Schedule", meta=(WorldContext="WorldContextObject"))
+	static UEnhancedSchedulePlayback* CreateFromCSV(UObject* WorldContextObject, const FString& CSV,
+		EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation,
+		AActor* DilationActor = nullptr, bool bAffectedByGamePause = false, int32 WindowSize = 32);
+
+	/** Playback of an event array (sorted by Time here if needed). */
+	static UEnhancedSchedulePlayback* CreateFromEvents(UObject* WorldContextObject, TArray<FEnhancedScheduleEvent>&& Events,
+		EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation,
+		AActor* DilationActor = nullptr, bool bAffectedByGamePause = false, int32 WindowSize = 32);
+
+	/** Start from the first event (restarts if already playing). */
+	UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Schedule")
+	void Play();
+
+	UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Schedule")
+	void Stop();
+
+	UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Schedule")
+	void SetPaused(bool bPaused);
+
+	UFUNCTION(BlueprintPure, Category="EnhancedTimers|Schedule")
+	bool IsPlaying() const { return bPlaying; }
+
+	/** Playback seconds since Play() (dilated, stopped while paused). */
+	UFUNCTION(BlueprintPure, Category="EnhancedTimers|Schedule")
+	float GetPlaybackTime() const;
+
+	UFUNCTION(BlueprintPure, Category="EnhancedTimers|Schedule")
+	int32 GetNumEvents() const { return Events.Num(); }
+
+	/** Events fired since Play(). */
+	UFUNCTION(BlueprintPure, Category="EnhancedTimers|Schedule")
+	int32 GetNumFired() const { return NumFired; }
+
+	/** Events currently materialized as timers (at most the window size). */
+	UFUNCTION(BlueprintPure, Category="EnhancedTimers|Schedule")
+	int32 GetNumMaterialized() const { return WindowTimers.Num(); }
+
+	UPROPERTY(BlueprintAssignable, Category="EnhancedTimers|Schedule")
+	FOnEnhancedScheduleEvent OnEvent;
+
+	UPROPERTY(BlueprintAssignable, Category="EnhancedTimers|Schedule")
+	FOnEnhancedScheduleFinished OnFinished;
+
+	virtual void BeginDestroy() override;
+
+private:
+	void MaterializeNext();
+	void HandleEventTimer(int32 EventIndex);
+
+	TArray<FEnhancedScheduleEvent>                  Events;          // sorted by Time
+	TWeakObjectPtr<UEnhancedTimerManagerSubsystem>  Subsystem;
+	EEnhancedTimerTimeDilationMode                  DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation;
+	TWeakObjectPtr<AActor>                          DilationActor;
+	bool                                            bAffectedByGamePause = false;
+	int32                                           WindowSize = 32;
+
+	FEnhancedTimerHandle                            ClockTimer;      // never fires; its elapsed time is the playback time
+	TMap<int32, FEnhancedTimerHandle>               WindowTimers;    // event index -> timer
+	int32                                           NextToMaterialize = 0;
+	int32                                           NumFired = 0;
+	bool                                            bPlaying = false;
+	bool                                            bPaused = false;
+};
@@ -0,0 +1,115 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "EnhancedTimerSet.h"
+
+/**
+ * Lightweight timer manager owned by one thread, for timeouts in worker-side code (IO threads, request loops)
+ * that should not round-trip through the Game Thread.
+ *
+ * Get() returns the calling thread's instance. Timers are real-time (FPlatformTime, no dilation or game pause)
+ * and are serviced by that thread only: its loop calls Service() and can bound its waits with GetWaitTime().
+ * Every method must be called on the owning thread, except the TFuture helper's completion path.
+ *
+ *     FEnhancedThreadTimers& Timers = FEnhancedThreadTimers::Get();
+ *     const uint64 Timeout = Timers.SetTimeout(5.f, [this]() { AbortRequest(); });
+ *     ...
+ *     Timers.Cancel(Timeout);
+ *
+ * Only meaningful on threads that keep running their own loop (FRunnable); pooled task workers do not.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedThreadTimers
+{
+public:
+	using FCallback = TUniqueFunction<void()>;
+
+	/** Timer manager of the calling thread (created on first use, destroyed with the thread). */
+	static FEnhancedThreadTimers& Get();
+
+	/** Run Callback once, Seconds from now, inside a later Service() of this thread. Returns the timer Id (never 0). */
+	uint64 SetTimeout(float Seconds, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token = FEnhancedTimerCancellationToken());
+
+	/** Run Callback every Seconds until cancelled. */
+	uint64 SetInterval(float Seconds, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token = FEnhancedTimerCancellationToken());
+
+	/** Returns true if the timer was pending. */
+	bool Cancel(uint64 Id);
+	void CancelAll();
+
+	bool  IsPending(uint64 Id) const;
+	int32 Num() const { return Timers.Num(); }
+
+	/** Fire due timers. Call from the owning thread's loop (not from a timer callback). Returns the number of callbacks executed. */
+	int32 Service();
+
+	/** Seconds until the next timeout may be due (0 if overdue, MAX_flt if none); use to bound waits. */
+	float GetWaitTime() const;
+
+	/** True once this thread called Service(), i.e. it runs a loop that delivers its timeouts. */
+	bool HasBeenServiced() const { return bServiced; }
+
+	/**
+	 * Future that resolves with the value of Future, or with an empty optional if it did not complete within
+	 * Seconds. The timeout is serviced by the calling thread; a completion on any other thread cancels it
+	 * through a token, without touching this manager.
+	 *
+	 * Only call it on a thread whose loop calls Service(), and after the first Service(): elsewhere (Game Thread,
+	 * task workers) the timeout never fires and the result waits for Future forever. Ensures otherwise.
+	 */
+	template<typename ResultType>
+	static TFuture<TOptional<ResultType>> WithTimeout(TFuture<ResultType>&& Future, float Seconds)
+	{
+		ensureMsgf(Get().HasBeenServiced(), TEXT("FEnhancedThreadTimers::WithTimeout on a thread that never called Service(): the timeout will not fire."));
+
+		struct FState
+		{
+			TPromise<TOptional<ResultType>> Promise;
+			std::atomic<bool>               bResolved{false};
+			FEnhancedTimerCancellationToken Token = FEnhancedTimerCancellationToken::Create();
+
+			bool TryResolve() { return !bResolved.exchange(true, std::memory_order_acq_rel); }
+		};
+
+		TSharedRef<FState, ESPMode::ThreadSafe> State = MakeShared<FState, ESPMode::ThreadSafe>();
+		TFuture<TOptional<ResultType>> Result = State->Promise.GetFuture();
+
+		Get().SetTimeout(Seconds, [State]()
+		{
+			if (State->TryResolve())
+			{
+				State->Promise.SetValue(TOptional<ResultType>());
+			}
+		}, State->Token);
+
+		Future.Then([State](TFuture<ResultType> Completed)
+		{
+			if (State->TryResolve())
+			{
+				State->Token.Cancel();
+				State->Promise.SetValue(TOptional<ResultType>(Completed.Consume()));
+			}
+		});
+
+		return Result;
+	}
+
+private:
+	FEnhancedThreadTimers();
+	FEnhancedThreadTimers(const FEnhancedThreadTimers&) = delete;
+	FEnhancedThreadTimers& operator=(const FEnhancedThreadTimers&) = delete;
+
+	uint64 AddTimer(float Seconds, bool bLoop, FCallback&& Callback, const FEnhancedTimerCancellationToken& Token);
+
+	FORCEINLINE void CheckOwnerThread() const
+	{
+		checkSlow(FPlatformTLS::GetCurrentThreadId() == OwnerThreadId);
+	}
+
+	TEnhancedTimerSet<FCallback> Timers;
+	double                       LastServiceTime = 0.0;
+	uint32                       OwnerThreadId = 0;
+	bool                         bServiced = false;
+};
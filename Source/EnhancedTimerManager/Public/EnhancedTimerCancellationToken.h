@@ -0,0 +1,54 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Shared cancellation flag that any number of timers can reference.
+ * Cancel() flips a single atomic (O(1) regardless of how many timers use the token);
+ * the subsystem drops the referencing timers lazily the next time it visits them.
+ * Copies share the same state; a default-constructed token is null and never cancelled.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedTimerCancellationToken
+{
+public:
+	FEnhancedTimerCancellationToken() = default;
+
+	/** Create a new, not yet cancelled token. */
+	static FEnhancedTimerCancellationToken Create()
+	{
+		FEnhancedTimerCancellationToken Token;
+		Token.State = MakeShared<FState, ESPMode::ThreadSafe>();
+		return Token;
+	}
+
+	/** Cancel every timer that references this token. Safe to call from any thread. */
+	FORCEINLINE void Cancel() const
+	{
+		if (State.IsValid())
+		{
+			State->bCancelled.store(true, std::memory_order_release);
+		}
+	}
+
+	FORCEINLINE bool IsCancelled() const
+	{
+		return State.IsValid() && State->bCancelled.load(std::memory_order_acquire);
+	}
+
+	/** True if the token was created with Create() (null tokens are never cancelled). */
+	FORCEINLINE bool IsValid() const { return State.IsValid(); }
+
+	bool operator==(const FEnhancedTimerCancellationToken& Other) const { return State == Other.State; }
+	bool operator!=(const FEnhancedTimerCancellationToken& Other) const { return State != Other.State; }
+
+private:
+	struct FState
+	{
+		std::atomic<bool> bCancelled{false};
+	};
+
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+};
@@ -7,90 +7,88 @@
 #include "Tickable.h"
 #include "TimerManager.h"                // FTimerDelegate / FTimerDynamicDelegate
 #include "Kismet/GameplayStatics.h"
+#include "GameplayTagContainer.h"
 #include "EnhancedTimerManagerTypes.h"
 #include "EnhancedTimerHandle.h"
+#include "EnhancedTimerCancellationToken.h"
+#include "EnhancedTimerSet.h"
+#include "EnhancedIntervalTicks.h"
+#include "EnhancedPollTimers.h"
+#include "EnhancedDeferredRelease.h"
+#include "EnhancedTokenBucket.h"
+#include "EnhancedRetryTimer.h"
+#include "EnhancedPhysicsTimerClock.h"
 #include "Engine/World.h" 
+#include "Engine/EngineBaseTypes.h"
 #include "Stats/Stats.h"
 #include "EnhancedTimerManagerSubsystem.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogEnhancedTimerManager, Log, All);
 
-/** Per-timer internal state (not exposed as USTRUCT). */
-struct FEnhancedTimerData
+class AEnhancedTimerReplicationProxy;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnhancedReplicatedTimerEvent, FName, Key);
+
+/** A timer crossed one of its milestones (TimeRemaining = the milestone's threshold). */
+DECLARE_DELEGATE_OneParam(FEnhancedTimerMilestoneDelegate, float /*TimeRemaining*/);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FEnhancedTimerMilestoneDynamicDelegate, float, TimeRemaining);
+
+/** Remaining-time threshold of a timer with its own callback (see SetTimerMilestones). */
+struct FEnhancedTimerMilestone
 {
-    /** Phase machine to make initial delay deterministic and simple. */
-    enum class ETimerPhase : uint8
-    {
-        InitialDelay,
-        Running
-    };
+    float                                  TimeRemaining = 0.f;
+    FEnhancedTimerMilestoneDelegate        Callback;
+};
 
-    uint64                                 Id = 0;
+/** Callback of a subsystem timer: a C++ delegate or a Blueprint dynamic delegate. */
+struct FEnhancedTimerDelegate
+{
     FTimerDelegate                         Delegate;             // C++ delegate (void return)
     FTimerDynamicDelegate                  DynamicDelegate;      // Blueprint delegate
     bool                                   bUseDynamic = false;  // true if DynamicDelegate is bound
-    bool                                   bLoop = false;
-    bool                                   bPaused = false;
-    bool                                   bAffectedByGamePause = false;
-    bool                                   bNextTick = false;
-
-    float                                  Duration = 0.f;       // seconds for Running phase
-    float                                  PhaseElapsed = 0.f;   // elapsed in current phase
-    float                                  InitialDelay = 0.f;   // seconds for InitialDelay phase
-    ETimerPhase                            Phase = ETimerPhase::Running;
-
-    EEnhancedTimerTimeDilationMode         DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
-    TWeakObjectPtr<AActor>                 DilationActor;
 
-    /** Compute effective delta time considering dilation mode. */
-    FORCEINLINE float GetEffectiveDelta(float WorldDelta, const UWorld* World) const
+    void operator()()
     {
-        switch (DilationMode)
+        if (bUseDynamic)
         {
-            case EEnhancedTimerTimeDilationMode::GlobalTimeDilation:
-                return World ? (WorldDelta * UGameplayStatics::GetGlobalTimeDilation(World)) : WorldDelta;
-            case EEnhancedTimerTimeDilationMode::ActorTimeDilation:
+            if (DynamicDelegate.IsBound())
             {
-                const AActor* A = DilationActor.Get();
-                if (A)
-                {
-                    const float Scale = FMath::Max(UE_SMALL_NUMBER, A->CustomTimeDilation);
-                    return WorldDelta * Scale;
-                }
-                // Fallback: actor invalid -> behave like IgnoreTimeDilation
-                return WorldDelta;
+                DynamicDelegate.ProcessDelegate<UObject>(nullptr);
             }
-            default:
-                return WorldDelta;
         }
-    }
-
-    /** Advance the phase timer. */
-    FORCEINLINE void Advance(float EffDelta) { PhaseElapsed += EffDelta; }
-
-    /** Transition from InitialDelay to Running; returns true if transition happened. */
-    FORCEINLINE bool TryTransitFromDelay()
-    {
-        if (Phase == ETimerPhase::InitialDelay && PhaseElapsed + KINDA_SMALL_NUMBER >= InitialDelay)
+        else if (Delegate.IsBound())
         {
-            Phase = ETimerPhase::Running;
-            PhaseElapsed = 0.f;
-            return true;
+            Delegate.Execute();
         }
-        return false;
     }
+};
 
-    /** Should fire in current phase? (only Running uses Duration threshold) */
-    FORCEINLINE bool ShouldFire() const
-    {
-        return (Phase == ETimerPhase::Running) && (PhaseElapsed + KINDA_SMALL_NUMBER >= Duration);
-    }
+/** Timers of one tick group of the subsystem. */
+using FEnhancedTimerSet = TEnhancedTimerSet<FEnhancedTimerDelegate>;
+
+/** Per-timer internal state (not exposed as USTRUCT). */
+using FEnhancedTimerData = FEnhancedTimerSet::FTimer;
+
+class UEnhancedTimerManagerSubsystem;
+
+/** Tick function that advances and fires the timers of one EEnhancedTimerTickGroup. */
+struct FEnhancedTimerTickFunction : public FTickFunction
+{
+    UEnhancedTimerManagerSubsystem* Owner = nullptr;
+    EEnhancedTimerTickGroup         Group = EEnhancedTimerTickGroup::Default;
+    bool                            bRequested = false;  // a timer was created in this group
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
 };
 
 /**
  * GameInstanceSubsystem + FTickableGameObject that manages time-dilation-aware timers.
  * All public API is intended to be used on the Game Thread; if called from other threads,
  * the call is marshalled back to the Game Thread.
+ * Timers created in a non-Default EEnhancedTimerTickGroup are fired from a tick function
+ * registered in the matching engine tick group instead of the tickable.
  */
 UCLASS(BlueprintType)
 class ENHANCEDTIMERMANAGER_API UEnhancedTimerManagerSubsystem
@@ -120,10 +118,12 @@ public:
                                           bool bAffectedByGamePause = false,
                                           bool bLoop = false,
                                           float DelayToStartCountingDown = 0.f,
-                                          float DelayToStartCountingDownVariation = 0.f);
+                                          float DelayToStartCountingDownVariation = 0.f,
+                                          EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
 
-    /** Execute a delegate on the next tick (frame). */
-    FEnhancedTimerHandle SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate);
+    /** Execute a delegate on the next tick (frame) of the given tick group. */
+    FEnhancedTimerHandle SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate,
+                                                            EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
 
     /**
      * Optional helper: Invoke SetEnhancedTimer on the Game Thread and return the handle via a completion callback.
@@ -152,8 +152,54 @@ public:
     float GetTimerElapsedTime(const FEnhancedTimerHandle& Handle) const;
     bool  IsTimerAffectedByGamePause(const FEnhancedTimerHandle& Handle) const;
     EEnhancedTimerTimeDilationMode GetTimerTimeDilationMode(const FEnhancedTimerHandle& Handle) const;
+    EEnhancedTimerTickGroup GetTimerTickGroup(const FEnhancedTimerHandle& Handle) const;
+    int32 GetTimerPriority(const FEnhancedTimerHandle& Handle) const;
+
+    /** Order among timers due at the same instant of a frame; higher fires first (default 0). */
+    void  SetTimerPriority(const FEnhancedTimerHandle& Handle, int32 Priority);
+
+    /** Background timers run their callbacks when the frame has headroom instead of on time (bounded deferral). */
+    void  SetTimerPriorityClass(const FEnhancedTimerHandle& Handle, EEnhancedTimerPriorityClass PriorityClass);
+    EEnhancedTimerPriorityClass GetTimerPriorityClass(const FEnhancedTimerHandle& Handle) const;
+
+    /** Background callbacks that are due but still waiting for frame headroom. */
+    int32 GetNumDeferredBackgroundTimers() const { return BackgroundQueue.Num(); }
+
+    /**
+     * Attach a shared cancellation token to a timer. Cancelling the token drops the timer lazily;
+     * it will not fire again and IsTimerValid returns false immediately.
+     */
+    void  SetTimerCancellationToken(const FEnhancedTimerHandle& Handle, const FEnhancedTimerCancellationToken& Token);
+
+    /**
+     * Per-timer speed on top of its dilation mode (1 = normal, 2 = counts down twice as fast). Changing it keeps
+     * the elapsed time of the current phase and only moves the pending deadline.
+     */
+    void  SetTimerTimeScale(const FEnhancedTimerHandle& Handle, float TimeScale);
+    float GetTimerTimeScale(const FEnhancedTimerHandle& Handle) const;
+
+    /**
+     * Call each milestone's callback when the time left in the timer's Running phase reaches its TimeRemaining
+     * ("10 s left", "5", "3", "2", "1"). The next milestone is the scheduled deadline of the timer, so one timer
+     * replaces a timer per warning and milestones follow its pause, dilation and time scale. Milestones already
+     * passed are skipped; looping timers cross them again every period. Replaces the previous milestones (empty
+     * array removes them).
+     */
+    void  SetTimerMilestones(const FEnhancedTimerHandle& Handle, TArray<FEnhancedTimerMilestone> Milestones);
+    int32 GetNumTimerMilestones(const FEnhancedTimerHandle& Handle) const;
+
+    /**
+     * Forecast of upcoming fire load: OutCounts[i] is the number of timer fires expected in [i, i + 1) * BucketSeconds
+     * from now, assuming dilation stays as it is (pass the frame time as BucketSeconds for a per-frame forecast).
+     * Looping timers count once per period. Computed from the deadline heaps; only timers due within the forecast
+     * are visited.
+     */
+    void  GetTimerForecast(float BucketSeconds, int32 NumBuckets, TArray<int32>& OutCounts) const;
 
     // Bulk operations
+    /** Invalidate several timers under a single write lock. Handles owned by another subsystem are skipped. */
+    void  InvalidateTimers(TConstArrayView<FEnhancedTimerHandle> Handles);
+
     UFUNCTION(BlueprintCallable, Category="EnhancedTimers")
     void InvalidateAllTimers();
 
@@ -163,6 +209,232 @@ public:
     UFUNCTION(BlueprintCallable, Category="EnhancedTimers")
     void UnpauseAllTimers();
 
+    // ========================= Gameplay tags =========================
+
+    /**
+     * Replace the gameplay tags of a timer (empty container removes them). Tag operations below visit only the
+     * timers indexed under the queried tag; a timer is indexed under its tags and all their parents, so
+     * querying Ability.Fire also matches timers tagged Ability.Fire.Charge.
+     */
+    void  SetTimerTags(const FEnhancedTimerHandle& Handle, const FGameplayTagContainer& Tags);
+    FGameplayTagContainer GetTimerTags(const FEnhancedTimerHandle& Handle) const;
+
+    /** Handles of the valid timers matching Tag (hierarchically). */
+    void  GetTimersWithTag(FGameplayTag Tag, TArray<FEnhancedTimerHandle>& OutHandles) const;
+
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|Tags")
+    int32 GetNumTimersWithTag(FGameplayTag Tag) const;
+
+    /** Returns the number of matching timers. */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Tags")
+    int32 PauseTimersWithTag(FGameplayTag Tag);
+
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Tags")
+    int32 UnpauseTimersWithTag(FGameplayTag Tag);
+
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Tags")
+    int32 InvalidateTimersWithTag(FGameplayTag Tag);
+
+    /** SetTimerTimeScale for every matching timer (e.g. slow every Status.Debuff timer). */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Tags")
+    int32 SetTimeScaleForTimersWithTag(FGameplayTag Tag, float TimeScale);
+
+    // ========================= Tick groups =========================
+
+    /** Make a timer tick group wait for another tick function (e.g. an actor's PrimaryActorTick). */
+    void AddTickGroupPrerequisite(EEnhancedTimerTickGroup Group, UObject* TargetObject, FTickFunction& TargetTickFunction);
+    void RemoveTickGroupPrerequisite(EEnhancedTimerTickGroup Group, UObject* TargetObject, FTickFunction& TargetTickFunction);
+
+    /** Make another tick function (e.g. an actor's PrimaryActorTick) wait until the timers of a tick group fired. */
+    void AddTickGroupDependent(EEnhancedTimerTickGroup Group, FTickFunction& DependentTickFunction);
+    void RemoveTickGroupDependent(EEnhancedTimerTickGroup Group, FTickFunction& DependentTickFunction);
+
+    /** Group timers wait for this actor's primary tick. */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|TickGroups")
+    void AddTickGroupPrerequisiteActor(EEnhancedTimerTickGroup Group, AActor* PrerequisiteActor);
+
+    /** This actor's primary tick waits until the group's timers fired. */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|TickGroups")
+    void AddTickGroupDependentActor(EEnhancedTimerTickGroup Group, AActor* DependentActor);
+
+    // ========================= Replication =========================
+
+    /**
+     * Server only: replicate a timer to clients under Key. Only the absolute end time (server world time)
+     * and pause/scale changes are sent; clients reconstruct the time left locally.
+     * Returns false on clients or if the timer is invalid.
+     */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Replication")
+    bool SetTimerReplicated(const FEnhancedTimerHandle& Handle, FName Key);
+
+    /** Server only: stop replicating the timer registered under Key (the timer itself keeps running). */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|Replication")
+    void StopReplicatingTimer(FName Key);
+
+    /** Time until the replicated timer next fires, or -1 if unknown. Works on server and clients. */
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|Replication")
+    float GetReplicatedTimerTimeLeft(FName Key) const;
+
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|Replication")
+    bool IsReplicatedTimerActive(FName Key) const;
+
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|Replication")
+    bool IsReplicatedTimerPaused(FName Key) const;
+
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|Replication")
+    float GetReplicatedTimerDuration(FName Key) const;
+
+    /** Clients: a replicated timer was added or changed (pause, scale, re-arm). */
+    UPROPERTY(BlueprintAssignable, Category="EnhancedTimers|Replication")
+    FOnEnhancedReplicatedTimerEvent OnReplicatedTimerUpdated;
+
+    /** Clients: a replicated timer finished or stopped replicating. */
+    UPROPERTY(BlueprintAssignable, Category="EnhancedTimers|Replication")
+    FOnEnhancedReplicatedTimerEvent OnReplicatedTimerRemoved;
+
+    /** Server corrections are only sent when the predicted end time drifts by more than this (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="EnhancedTimers|Replication")
+    float ReplicationTolerance = 0.05f;
+
+    void RegisterReplicationProxy(AEnhancedTimerReplicationProxy* Proxy);
+    void UnregisterReplicationProxy(AEnhancedTimerReplicationProxy* Proxy);
+
+    // ========================= Interval ticks =========================
+
+    /**
+     * Call Callback every Interval seconds (0 = every frame) from the subsystem tick, without a tick function.
+     * Registrations sharing interval and dilation domain are processed as one dense batch with random phase
+     * offsets. Bind the delegate to its owner (CreateUObject / CreateWeakLambda): registrations of destroyed
+     * owners are dropped automatically. Returns an invalid handle when called off the Game Thread.
+     */
+    FEnhancedIntervalTickHandle RegisterIntervalTick(float Interval,
+                                                     FEnhancedIntervalTickDelegate Callback,
+                                                     EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+                                                     AActor* DilationActor = nullptr,
+                                                     bool bAffectedByGamePause = false);
+
+    /** Stop an interval tick and invalidate the handle. */
+    void  UnregisterIntervalTick(FEnhancedIntervalTickHandle& Handle);
+
+    int32 GetNumIntervalTicks() const { return IntervalTicks.Num(); }
+
+    // ========================= Poll timers =========================
+
+    /**
+     * Poll Predicate until it returns true, then call OnFinished(true) once; OnFinished(false) if Settings.Timeout
+     * runs out first. Polls start fast and back off while the predicate keeps failing; all polls of a dilation
+     * domain are scanned as one batch per frame. Bind the predicate to its owner (CreateUObject /
+     * CreateWeakLambda): polls of destroyed owners are dropped without a callback. Returns an invalid handle when
+     * called off the Game Thread.
+     */
+    FEnhancedPollHandle SetPollTimer(FEnhancedPollPredicate Predicate,
+                                     FEnhancedPollFinishedDelegate OnFinished,
+                                     const FEnhancedPollSettings& Settings = FEnhancedPollSettings(),
+                                     EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+                                     AActor* DilationActor = nullptr,
+                                     bool bAffectedByGamePause = false);
+
+    /** Stop a poll without calling OnFinished and invalidate the handle. */
+    void  ClearPollTimer(FEnhancedPollHandle& Handle);
+
+    int32 GetNumPollTimers() const { return PollTimers.Num(); }
+
+    // ========================= Deferred release =========================
+
+    /** Destroy Actor after Seconds of game time (batched replacement for AActor::SetLifeSpan). */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|DeferredRelease")
+    void DestroyActorAfter(AActor* Actor, float Seconds);
+
+    /** Register a custom release action once (e.g. a pool's return function); use the id with ReleaseObjectAfter. */
+    uint16 RegisterDeferredReleaseAction(FEnhancedDeferredReleaseDelegate Action);
+
+    /** Run a registered action on Object after Seconds of game time. Replaces a pending release of the object. */
+    void  ReleaseObjectAfter(UObject* Object, float Seconds, uint16 Action);
+
+    /** Cancel the pending destroy/release of Object (e.g. a pooled object acquired again). */
+    UFUNCTION(BlueprintCallable, Category="EnhancedTimers|DeferredRelease")
+    bool  CancelDeferredRelease(UObject* Object);
+
+    /** Seconds until Object is destroyed/released, or -1 if nothing is pending. */
+    UFUNCTION(BlueprintPure, Category="EnhancedTimers|DeferredRelease")
+    float GetDeferredReleaseTimeLeft(UObject* Object) const;
+
+    int32 GetNumDeferredReleases() const { return DeferredRelease.Num(); }
+
+    // ========================= Retry timers =========================
+
+    /**
+     * Call Attempt until it returns true or Policy.MaxAttempts attempts failed, waiting Policy.GetDelay before each
+     * attempt (exponential backoff, capped, jitter from a stream seeded with Policy.Seed). A single timer entry
+     * re-arms itself with the next delay, so the handle stays the same for the whole sequence and works with the
+     * regular timer API: InvalidateTimer stops retrying (without OnFinished), PauseTimer, GetTimerTimeLeft, tags.
+     */
+    FEnhancedTimerHandle SetRetryTimer(const FEnhancedRetryPolicy& Policy,
+                                       FEnhancedRetryAttemptDelegate Attempt,
+                                       FEnhancedRetryFinishedDelegate OnFinished = FEnhancedRetryFinishedDelegate(),
+                                       EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+                                       AActor* DilationActor = nullptr,
+                                       bool bAffectedByGamePause = false,
+                                       EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
+
+    /** Attempts made so far, or -1 if the handle is not a running retry timer. */
+    int32 GetRetryAttemptCount(const FEnhancedTimerHandle& Handle) const;
+
+    /** Delay armed before the next attempt, or -1 if the handle is not a running retry timer. */
+    float GetRetryNextDelay(const FEnhancedTimerHandle& Handle) const;
+
+    // ========================= Rate limiters =========================
+
+    /**
+     * Token bucket (Capacity tokens, RefillPerSecond) refilled lazily from the clock of a timer domain, so an idle
+     * limiter costs nothing: no tick, no timer. Its time follows the dilation mode and game pause behaviour like a
+     * timer with the same settings. Create / Destroy / TryConsume / queries take the timer lock and may be called
+     * from any thread.
+     */
+    FEnhancedRateLimiterHandle CreateRateLimiter(float Capacity,
+                                                 float RefillPerSecond,
+                                                 EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+                                                 AActor* DilationActor = nullptr,
+                                                 bool bAffectedByGamePause = false);
+
+    /** Destroy a limiter (and its pending availability callback) and invalidate the handle. */
+    void  DestroyRateLimiter(FEnhancedRateLimiterHandle& Handle);
+
+    /** Take Amount tokens if available. O(1). Returns false for an invalid handle. */
+    bool  TryConsumeRateLimiter(const FEnhancedRateLimiterHandle& Handle, float Amount = 1.f);
+
+    /** Tokens available now, or -1 for an invalid handle. */
+    float GetRateLimiterTokens(const FEnhancedRateLimiterHandle& Handle) const;
+
+    /** Limiter seconds until Amount tokens are available (0 = now), or -1 for an invalid handle or never. */
+    float GetRateLimiterTimeUntilAvailable(const FEnhancedRateLimiterHandle& Handle, float Amount = 1.f) const;
+
+    /**
+     * Run Callback once Amount tokens are available (right away if they are). Waiting uses a one-shot timer on the
+     * limiter's clock that only exists while somebody waits; a new call replaces the previous wait. Tokens are not
+     * consumed: call TryConsumeRateLimiter from the callback.
+     */
+    void  NotifyWhenRateLimiterAvailable(const FEnhancedRateLimiterHandle& Handle, float Amount, const FTimerDelegate& Callback);
+
+    int32 GetNumRateLimiters() const;
+
+    // ========================= Physics-domain timers =========================
+
+    /**
+     * Schedule a callback on the physics clock of the current world. The clock advances inside the Chaos
+     * pre-simulate callback, so timers resolve at (async) substep granularity and fire on the physics thread.
+     * The clock is owned and used by the Game Thread only. Calls from other threads (physics callbacks, workers)
+     * push a command onto a lock-free MPSC queue that the next subsystem tick forwards to the clock; their handle is
+     * allocated up front, so it can be cancelled right away. Without a physics scene the timer is dropped (the
+     * Game Thread call returns an invalid handle).
+     */
+    FEnhancedPhysicsTimerHandle SetPhysicsTimer(FEnhancedPhysicsTimerClock::FCallback&& Callback, float Duration, bool bLoop = false);
+    void   CancelPhysicsTimer(const FEnhancedPhysicsTimerHandle& Handle);
+    void   CancelAllPhysicsTimers();
+
+    /** Physics-domain time published by the last physics step (0 if no physics timer was ever set); off the Game Thread, as of the last subsystem tick. */
+    double GetPhysicsClockTime() const;
+
     // ========================= Blueprint API =========================
 
     UFUNCTION(BlueprintCallable, DisplayName="Set Enhanced Timer", Category="EnhancedTimers", meta=(WorldContext="WorldContextObject"))
@@ -174,11 +446,13 @@ public:
         bool bAffectedByGamePause = false,
         bool bLoop = false,
         float DelayToStartCountingDown = 0.f,
-        float DelayToStartCountingDownVariation = 0.f);
+        float DelayToStartCountingDownVariation = 0.f,
+        EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
 
     UFUNCTION(BlueprintCallable, DisplayName="Set Enhanced Timer Executed In Next Tick", Category="EnhancedTimers", meta=(WorldContext="WorldContextObject"))
     FEnhancedTimerHandle SetEnhancedTimerExecutedInNextTick_BP(const UObject* WorldContextObject,
-        const FTimerDynamicDelegate& Event);
+        const FTimerDynamicDelegate& Event,
+        EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
 
     UFUNCTION(BlueprintCallable, DisplayName="Is Timer Valid", Category="EnhancedTimers")
     bool IsTimerValid_BP(FEnhancedTimerHandle Handle) const { return IsTimerValid(Handle); }
@@ -213,40 +487,221 @@ public:
     UFUNCTION(BlueprintPure, DisplayName="Get Timer Time Dilation Mode", Category="EnhancedTimers")
     EEnhancedTimerTimeDilationMode GetTimerTimeDilationMode_BP(FEnhancedTimerHandle Handle) const { return GetTimerTimeDilationMode(Handle); }
 
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Tick Group", Category="EnhancedTimers")
+    EEnhancedTimerTickGroup GetTimerTickGroup_BP(FEnhancedTimerHandle Handle) const { return GetTimerTickGroup(Handle); }
+
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Priority", Category="EnhancedTimers")
+    int32 GetTimerPriority_BP(FEnhancedTimerHandle Handle) const { return GetTimerPriority(Handle); }
+
+    UFUNCTION(BlueprintCallable, DisplayName="Set Timer Priority", Category="EnhancedTimers")
+    void SetTimerPriority_BP(FEnhancedTimerHandle Handle, int32 Priority) { SetTimerPriority(Handle, Priority); }
+
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Priority Class", Category="EnhancedTimers")
+    EEnhancedTimerPriorityClass GetTimerPriorityClass_BP(FEnhancedTimerHandle Handle) const { return GetTimerPriorityClass(Handle); }
+
+    UFUNCTION(BlueprintCallable, DisplayName="Set Timer Priority Class", Category="EnhancedTimers")
+    void SetTimerPriorityClass_BP(FEnhancedTimerHandle Handle, EEnhancedTimerPriorityClass PriorityClass) { SetTimerPriorityClass(Handle, PriorityClass); }
+
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Forecast", Category="EnhancedTimers")
+    TArray<int32> GetTimerForecast_BP(float BucketSeconds, int32 NumBuckets) const
+    {
+        TArray<int32> Counts;
+        GetTimerForecast(BucketSeconds, NumBuckets, Counts);
+        return Counts;
+    }
+
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Time Scale", Category="EnhancedTimers")
+    float GetTimerTimeScale_BP(FEnhancedTimerHandle Handle) const { return GetTimerTimeScale(Handle); }
+
+    UFUNCTION(BlueprintCallable, DisplayName="Set Timer Time Scale", Category="EnhancedTimers")
+    void SetTimerTimeScale_BP(FEnhancedTimerHandle Handle, float TimeScale) { SetTimerTimeScale(Handle, TimeScale); }
+
+    /** Blueprint form of SetTimerMilestones: one event for every threshold, called with the threshold. */
+    UFUNCTION(BlueprintCallable, DisplayName="Set Timer Milestones", Category="EnhancedTimers")
+    void SetTimerMilestones_BP(FEnhancedTimerHandle Handle, const TArray<float>& TimesRemaining, const FEnhancedTimerMilestoneDynamicDelegate& Event);
+
+    UFUNCTION(BlueprintPure, DisplayName="Get Timer Tags", Category="EnhancedTimers|Tags")
+    FGameplayTagContainer GetTimerTags_BP(FEnhancedTimerHandle Handle) const { return GetTimerTags(Handle); }
+
+    UFUNCTION(BlueprintCallable, DisplayName="Set Timer Tags", Category="EnhancedTimers|Tags")
+    void SetTimerTags_BP(FEnhancedTimerHandle Handle, FGameplayTagContainer Tags) { SetTimerTags(Handle, Tags); }
+
+    UFUNCTION(BlueprintCallable, DisplayName="Get Timers With Tag", Category="EnhancedTimers|Tags")
+    TArray<FEnhancedTimerHandle> GetTimersWithTag_BP(FGameplayTag Tag) const
+    {
+        TArray<FEnhancedTimerHandle> Handles;
+        GetTimersWithTag(Tag, Handles);
+        return Handles;
+    }
+
 #if WITH_EDITOR || UE_BUILD_DEVELOPMENT
     UFUNCTION(CallInEditor, Category="EnhancedTimers|Debug")
     void DumpActiveTimers() const;
 #endif
 
 private:
+    static constexpr int32  NumTickGroups   = (int32)EEnhancedTimerTickGroup::Num;
+    static constexpr uint32 TickGroupIdBits = FEnhancedTimerSet::FStorage::TagBits;   // low bits of every Id hold the tick group
+    static_assert(NumTickGroups <= (1 << TickGroupIdBits), "Tick group does not fit in the Id bits");
+
+    /** Timers of one tick group. */
+    struct FTimerGroup
+    {
+        FEnhancedTimerSet                Timers;
+        TArray<FEnhancedFiredTimer>      FiredThisTick;     // to be executed this frame, in fire order
+    };
+
     // Internal storage
-    TMap<uint64, FEnhancedTimerData> Timers;
-    TArray<uint64>                   FiredThisTick;     // to be executed this frame
+    FTimerGroup                      Groups[NumTickGroups];
     TArray<uint64>                   ToRemove;          // remove at end of frame
     TArray<uint64>                   ToUnpause;         // deferred unpause if needed
-    uint64                           NextId = 1;
 
     // Reusable buffers to avoid per-tick allocations
-    mutable TArray<uint64>                                   ReusableToFire;
-    mutable TArray<TPair<uint64, FEnhancedTimerData>>        ReusableSnapshot;
+    mutable TArray<FEnhancedFiredTimer>                      ReusableToFire;
+
+    /** A background timer that is due and waits for frame headroom (completed when its callback runs). */
+    struct FBackgroundFire
+    {
+        uint64 Id = 0;
+        double QueuedTime = 0.0;
+    };
+    TArray<FBackgroundFire>          BackgroundQueue;   // FIFO
+
+    // Gameplay tag index (guarded by MapLock)
+    TMap<uint64, FGameplayTagContainer>  TimerTags;     // explicit tags of tagged timers
+    TMap<FGameplayTag, TSet<uint64>>     TagIndex;      // every tag and its parents -> timers
+    TArray<uint64>                       ReusableTagQuery;
 
     // Concurrency
     mutable FRWLock                  MapLock;
 
+    // EnhancedTimers.Engine value pushed to the groups (-1 = not yet)
+    int32                            AppliedEngineMode = -1;
+
+    // Tick functions for every group except Default (index 0 unused)
+    FEnhancedTimerTickFunction       GroupTickFunctions[NumTickGroups];
+    TWeakObjectPtr<UWorld>           TickFunctionsWorld;
+    FDelegateHandle                  WorldCleanupHandle;
+
+    // Replication bridge (spawned on the server, registered by the replicated actor on clients)
+    TWeakObjectPtr<AEnhancedTimerReplicationProxy> ReplicationProxy;
+
+    // Process-wide service mode (see FEnhancedTimerService): the Default group is advanced by the service
+    bool                             bUseSharedService = false;
+    float                            SharedPendingDelta = 0.f;     // world delta accumulated since the last service advance
+    float                            SharedAdvanceDelta = 0.f;     // inputs captured on the Game Thread for the worker advance
+    bool                             bSharedGamePaused = false;
+    TArray<float>                    SharedDomainRates;            // dilation rate per Default-group domain
+    TArray<uint64>                   SharedRemovedIds;             // timers dropped by the worker advance; indexes updated on the Game Thread
+
+    // Interval ticks (Game Thread only, ticked with the Default group)
+    FEnhancedIntervalTicks           IntervalTicks;
+
+    // Poll timers (Game Thread only, ticked after the interval ticks)
+    FEnhancedPollTimers              PollTimers;
+
+    // Deferred destroy/release entries (Game Thread only)
+    FEnhancedDeferredRelease         DeferredRelease;
+
+    /** Token bucket reading the clock of a domain of the Default group (guarded by MapLock). */
+    struct FRateLimiter
+    {
+        FEnhancedTokenBucket             Bucket;
+        int32                            ClockIndex = INDEX_NONE;   // Groups[Default].Timers.AcquireClock
+        EEnhancedTimerTimeDilationMode   DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
+        TWeakObjectPtr<AActor>           DilationActor;
+        bool                             bAffectedByGamePause = false;
+        uint64                           WaitTimerId = 0;           // pending NotifyWhenRateLimiterAvailable
+    };
+    TEnhancedPagedStorage<FRateLimiter>  RateLimiters;
+
+    /** Backoff state of a retry timer, keyed by timer Id (guarded by MapLock, dropped with the timer). */
+    struct FRetryState
+    {
+        FEnhancedRetryPolicy             Policy;
+        FRandomStream                    Stream;
+        int32                            Attempts = 0;
+        float                            NextDelay = 0.f;
+        FEnhancedRetryAttemptDelegate    Attempt;
+        FEnhancedRetryFinishedDelegate   OnFinished;
+    };
+    TMap<uint64, FRetryState>            RetryStates;
+
+    /** Milestone callbacks by timer Id, in the set's threshold order (guarded by MapLock, dropped with the timer). */
+    TMap<uint64, TArray<FEnhancedTimerMilestone>> TimerMilestones;
+
+    // Physics-domain clock (owned by the world's solver callback, used on the Game Thread only)
+    FEnhancedPhysicsTimerClock*      PhysicsClock = nullptr;
+    TWeakObjectPtr<UWorld>           PhysicsClockWorld;
+
+    /** Physics timer call made off the Game Thread, forwarded to the clock by the next tick. */
+    struct FPhysicsCommand
+    {
+        enum class EType : uint8 { Add, Cancel, CancelAll };
+
+        EType                                 Type = EType::Add;
+        FEnhancedPhysicsTimerHandle           Handle;
+        float                                 Duration = 0.f;
+        bool                                  bLoop = false;
+        FEnhancedPhysicsTimerClock::FCallback Callback;
+    };
+    TQueue<FPhysicsCommand, EQueueMode::Mpsc> PhysicsCommands;
+    std::atomic<double>              PublishedPhysicsTime{0.0};   // clock time as of the last tick, for other threads
+
 #if WITH_EDITOR || UE_BUILD_DEVELOPMENT
     mutable double                   LastTickTimeMs = 0.0;
     mutable int32                    TimersProcessedLastTick = 0;
+    uint64                           StatsFrameCounter = 0;
 #endif
 
     // Helpers
-    uint64  AllocateId();
     bool    GetData(uint64 Id, FEnhancedTimerData& Out) const;
     FEnhancedTimerData* FindMutable(uint64 Id);
-    void    ExecuteFired();
+    const FEnhancedTimerSet* FindSet(uint64 Id) const;
+    const FEnhancedTimerData* FindTimer(uint64 Id) const;         // caller holds MapLock
+    uint64  AddTimer(FEnhancedTimerData&& Data, EEnhancedTimerTickGroup Group);
+    void    InvalidateTimerIds(TConstArrayView<uint64> Ids);
+    void    UnindexTimerTags(uint64 Id);                                                  // caller holds MapLock
+    void    CollectTimersWithTag(const FGameplayTag& Tag, TArray<uint64>& OutIds) const;  // caller holds MapLock
+    void    TickTimerGroup(EEnhancedTimerTickGroup Group, float DeltaTime);
+    void    ExecuteFired(FTimerGroup& Group);
+    bool    FireAndComplete(uint64 Id);
+    void    FireMilestone(uint64 Id, int32 Milestone);
+    void    DrainBackgroundQueue();
     void    Cleanup();
+    void    BeginFrameStats();
+    void    RefreshEngineSettings();
+    void    RunRetryAttempt(uint64 Id);
+
+    // Shared service (Game Thread, then any worker thread)
+    bool    BeginSharedAdvance();
+    void    RunSharedAdvance();
+    void    FlushSharedRemovals();
+    void    ForgetRemovedTimer(uint64 Id);                                                // caller holds MapLock
+
+    static FORCEINLINE int32 GroupIndexFromId(uint64 Id) { return (int32)(Id & ((1ull << TickGroupIdBits) - 1)); }
+
+    // Tick group registration
+    void    RequestGroupTick(EEnhancedTimerTickGroup Group);
+    void    RegisterGroupTickFunctions(UWorld* World);
+    void    UnregisterGroupTickFunctions();
+    void    HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    // Physics clock
+    FEnhancedPhysicsTimerClock* GetOrCreatePhysicsClock();
+    void    ReleasePhysicsClock();
+    void    DrainPhysicsCommands();
+
+    // Replication
+    AEnhancedTimerReplicationProxy* GetOrSpawnReplicationProxy();
+    void    UpdateReplicatedTimers(UWorld* World);
 
     void    EnforceGameThread() const;
     bool    IsGamePaused() const;
+
+    friend class FEnhancedTimerScope;
+    friend class FEnhancedTimerService;
+    friend struct FEnhancedTimerTickFunction;
 };
 
 // ===== Inline template helper implementation =====
@@ -18,3 +18,43 @@ enum class EEnhancedTimerTimeDilationMode : uint8
 	/** Timer scales with a specific Actor's CustomTimeDilation (fallback to Ignore if Actor is invalid). */
 	ActorTimeDilation  UMETA(DisplayName="Actor")
 };
+
+/**
+ * Where in the frame a timer is advanced and fired.
+ * Default timers are driven by the subsystem's FTickableGameObject tick (after the world tick groups);
+ * every other value is dispatched from its own tick function registered in the matching engine tick group.
+ */
+UENUM(BlueprintType)
+enum class EEnhancedTimerTickGroup : uint8
+{
+	/** Ticked by the subsystem's FTickableGameObject. */
+	Default        UMETA(DisplayName="Default"),
+
+	/** Fired in TG_PrePhysics, before physics simulation starts. */
+	PrePhysics     UMETA(DisplayName="Pre Physics"),
+
+	/** Fired in TG_DuringPhysics, in parallel with physics simulation. */
+	DuringPhysics  UMETA(DisplayName="During Physics"),
+
+	/** Fired in TG_PostPhysics, once physics results are available. */
+	PostPhysics    UMETA(DisplayName="Post Physics"),
+
+	/** Fired in TG_PostUpdateWork, after cameras and most gameplay have updated. */
+	PostUpdateWork UMETA(DisplayName="Post Update Work"),
+
+	Num            UMETA(Hidden)
+};
+
+/** How urgently a fired timer's callback must run. */
+UENUM(BlueprintType)
+enum class EEnhancedTimerPriorityClass : uint8
+{
+	/** Callback runs in the frame the timer fires. */
+	Normal      UMETA(DisplayName="Normal"),
+
+	/**
+	 * Housekeeping: once due, the callback is queued and only run while the frame has headroom
+	 * (EnhancedTimers.Background.TargetFrameMs), or at the latest after EnhancedTimers.Background.MaxDeferral.
+	 */
+	Background  UMETA(DisplayName="Background")
+};
@@ -0,0 +1,247 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * Paged slot storage with stable element addresses.
+ *
+ * Elements live in fixed-size pages that are never moved or reallocated: growing allocates one more page
+ * (no rehash, no copy of existing elements), so insert cost stays flat and pointers returned by Find remain
+ * valid until the element is removed. Freed slots go back to their page's free list, and pages with free slots
+ * (including fully empty ones) are reused before a new page is allocated.
+ *
+ * Ids encode the slot, a per-slot generation (stale Ids of removed elements never resolve) and a small
+ * owner-defined tag in the low TagBits bits. 0 is never a valid Id. Not thread-safe.
+ */
+template<typename ElementType, uint32 PageSize = 256>
+class TEnhancedPagedStorage
+{
+public:
+	static constexpr uint32 TagBits        = 3;
+	static constexpr uint32 SlotBits       = 32;
+	static constexpr uint32 GenerationBits = 64 - SlotBits - TagBits;
+	static constexpr uint32 MaxTag         = (1u << TagBits) - 1;
+
+	TEnhancedPagedStorage() = default;
+	TEnhancedPagedStorage(const TEnhancedPagedStorage&) = delete;
+	TEnhancedPagedStorage& operator=(const TEnhancedPagedStorage&) = delete;
+	~TEnhancedPagedStorage() { Empty(); }
+
+	/** Move Value into a free slot and return it; OutId receives its Id (with Tag in the low bits). */
+	ElementType& Add(ElementType&& Value, uint32 Tag, uint64& OutId)
+	{
+		check(Tag <= MaxTag);
+
+		const int32 PageIndex = AcquirePageWithFreeSlot();
+		FPage& Page = *Pages[PageIndex];
+
+		const uint32 SlotInPage = Page.FreeHead;
+		FSlot& Slot = Page.Slots[SlotInPage];
+		Page.FreeHead = Slot.NextFree;
+		++Page.NumLive;
+		++NumLive;
+
+		if (Page.FreeHead == InvalidSlot)
+		{
+			PagesWithFree.Pop(EAllowShrinking::No);
+			Page.bInFreeList = false;
+		}
+
+		Slot.bLive = true;
+		ElementType* Element = new (Slot.Storage.GetTypedPtr()) ElementType(MoveTemp(Value));
+
+		const uint64 SlotIndex = (uint64)PageIndex * PageSize + SlotInPage;
+		OutId = ((uint64)Slot.Generation << (SlotBits + TagBits)) | (SlotIndex << TagBits) | Tag;
+		return *Element;
+	}
+
+	ElementType* Find(uint64 Id)
+	{
+		FSlot* Slot = FindSlot(Id);
+		return Slot ? Slot->Storage.GetTypedPtr() : nullptr;
+	}
+
+	const ElementType* Find(uint64 Id) const
+	{
+		return const_cast<TEnhancedPagedStorage*>(this)->Find(Id);
+	}
+
+	bool Remove(uint64 Id)
+	{
+		FSlot* Slot = FindSlot(Id);
+		if (!Slot) return false;
+
+		Slot->Storage.GetTypedPtr()->~ElementType();
+		Slot->bLive = false;
+
+		Slot->Generation = NextGeneration(Slot->Generation);   // invalidates the Id
+
+		const uint64 SlotIndex  = (Id >> TagBits) & ((1ull << SlotBits) - 1);
+		const int32  PageIndex  = (int32)(SlotIndex / PageSize);
+		FPage&       Page       = *Pages[PageIndex];
+		Slot->NextFree = Page.FreeHead;
+		Page.FreeHead  = (uint32)(SlotIndex % PageSize);
+		--Page.NumLive;
+		--NumLive;
+
+		if (!Page.bInFreeList)
+		{
+			PagesWithFree.Add(PageIndex);
+			Page.bInFreeList = true;
+		}
+		return true;
+	}
+
+	int32 Num() const { return NumLive; }
+	int32 NumPages() const { return Pages.Num(); }
+
+	/** Make room for Number elements in total (allocates pages now rather than on insert). */
+	void Reserve(int32 Number)
+	{
+		while (Pages.Num() * (int32)PageSize < Number)
+		{
+			AllocatePage();
+		}
+	}
+
+	/** Destroy every element but keep the pages for reuse. */
+	void Reset()
+	{
+		PagesWithFree.Reset();
+		for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+		{
+			FPage& Page = *Pages[PageIndex];
+			for (uint32 i = 0; i < PageSize; ++i)
+			{
+				FSlot& Slot = Page.Slots[i];
+				if (Slot.bLive)
+				{
+					Slot.Storage.GetTypedPtr()->~ElementType();
+					Slot.bLive = false;
+					Slot.Generation = NextGeneration(Slot.Generation);
+				}
+			}
+			InitFreeList(Page);
+			Page.bInFreeList = true;
+			PagesWithFree.Add(PageIndex);
+		}
+		NumLive = 0;
+	}
+
+	/** Destroy every element and release the pages. */
+	void Empty()
+	{
+		Reset();
+		Pages.Empty();
+		PagesWithFree.Empty();
+
+		// Pages allocated later start at a new generation so that Ids handed out before stay stale.
+		BaseGeneration = NextGeneration(BaseGeneration);
+	}
+
+	template<typename FuncType>
+	void ForEach(FuncType&& Func)
+	{
+		for (const TUniquePtr<FPage>& Page : Pages)
+		{
+			if (Page->NumLive == 0) continue;
+			for (FSlot& Slot : Page->Slots)
+			{
+				if (Slot.bLive) Func(*Slot.Storage.GetTypedPtr());
+			}
+		}
+	}
+
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (const TUniquePtr<FPage>& Page : Pages)
+		{
+			if (Page->NumLive == 0) continue;
+			for (const FSlot& Slot : Page->Slots)
+			{
+				if (Slot.bLive) Func(*Slot.Storage.GetTypedPtr());
+			}
+		}
+	}
+
+private:
+	static constexpr uint32 InvalidSlot = MAX_uint32;
+
+	struct FSlot
+	{
+		TTypeCompatibleBytes<ElementType> Storage;
+		uint32                            Generation = 1;
+		uint32                            NextFree = InvalidSlot;
+		bool                              bLive = false;
+	};
+
+	struct FPage
+	{
+		FSlot  Slots[PageSize];
+		uint32 FreeHead = 0;
+		uint32 NumLive = 0;
+		bool   bInFreeList = false;
+	};
+
+	/** Generation 0 is reserved so that no Id is 0. */
+	static uint32 NextGeneration(uint32 Generation)
+	{
+		return Generation >= (uint32)((1ull << GenerationBits) - 1) ? 1 : Generation + 1;
+	}
+
+	static void InitFreeList(FPage& Page)
+	{
+		for (uint32 i = 0; i < PageSize; ++i)
+		{
+			Page.Slots[i].NextFree = i + 1 < PageSize ? i + 1 : InvalidSlot;
+		}
+		Page.FreeHead = 0;
+		Page.NumLive  = 0;
+	}
+
+	int32 AllocatePage()
+	{
+		check((uint64)(Pages.Num() + 1) * PageSize <= (1ull << SlotBits));
+
+		TUniquePtr<FPage> Page = MakeUnique<FPage>();
+		for (FSlot& Slot : Page->Slots)
+		{
+			Slot.Generation = BaseGeneration;
+		}
+		InitFreeList(*Page);
+		Page->bInFreeList = true;
+
+		const int32 PageIndex = Pages.Add(MoveTemp(Page));
+		PagesWithFree.Add(PageIndex);
+		return PageIndex;
+	}
+
+	/** Most recently freed page first (warm in cache), otherwise a new page. */
+	int32 AcquirePageWithFreeSlot()
+	{
+		return PagesWithFree.Num() > 0 ? PagesWithFree.Last() : AllocatePage();
+	}
+
+	FSlot* FindSlot(uint64 Id)
+	{
+		if (Id == 0) return nullptr;
+
+		const uint64 SlotIndex = (Id >> TagBits) & ((1ull << SlotBits) - 1);
+		const uint64 PageIndex = SlotIndex / PageSize;
+		if (PageIndex >= (uint64)Pages.Num()) return nullptr;
+
+		FSlot& Slot = Pages[(int32)PageIndex]->Slots[SlotIndex % PageSize];
+		const uint32 Generation = (uint32)(Id >> (SlotBits + TagBits));
+		return (Slot.bLive && Slot.Generation == Generation) ? &Slot : nullptr;
+	}
+
+	TArray<TUniquePtr<FPage>> Pages;            // only the page pointers move when this grows
+	TArray<int32>             PagesWithFree;    // stack of pages that have at least one free slot
+	int32                     NumLive = 0;
+	uint32                    BaseGeneration = 1;
+};
@@ -0,0 +1,129 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "EnhancedTimerReplicationProxy.generated.h"
+
+class AEnhancedTimerReplicationProxy;
+struct FEnhancedReplicatedTimerArray;
+
+/**
+ * Replicated state of one server timer.
+ * Only the absolute end time (server world time) and pause/scale changes are sent;
+ * clients reconstruct the time left locally, so a running timer costs no network traffic.
+ */
+USTRUCT(BlueprintType)
+struct ENHANCEDTIMERMANAGER_API FEnhancedReplicatedTimerEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Key chosen by the server when the timer was made replicated. */
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	FName Key;
+
+	/** Server world time at which the timer next fires (valid while not paused). */
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	double EndServerTime = 0.0;
+
+	/** Timer seconds per server world second (time dilation of the timer). */
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	float TimeScale = 1.f;
+
+	/** Time left when the timer was paused (valid while paused). */
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	float RemainingWhenPaused = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	float Duration = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	bool bPaused = false;
+
+	UPROPERTY(BlueprintReadOnly, Category="EnhancedTimers")
+	bool bLoop = false;
+
+	/** Server-side timer Id (not replicated). */
+	uint64 TimerId = 0;
+
+	/** Time left at ServerTime, reconstructed locally. */
+	float GetTimeLeft(double ServerTime) const
+	{
+		if (bPaused) return RemainingWhenPaused;
+		return FMath::Max(0.f, (float)((EndServerTime - ServerTime) * TimeScale));
+	}
+
+	void PostReplicatedAdd(const FEnhancedReplicatedTimerArray& InArraySerializer);
+	void PostReplicatedChange(const FEnhancedReplicatedTimerArray& InArraySerializer);
+	void PreReplicatedRemove(const FEnhancedReplicatedTimerArray& InArraySerializer);
+};
+
+/** Delta-serialized array of replicated timers (only changed entries are sent). */
+USTRUCT()
+struct ENHANCEDTIMERMANAGER_API FEnhancedReplicatedTimerArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FEnhancedReplicatedTimerEntry> Items;
+
+	/** Owning proxy, used to forward client-side notifications. */
+	AEnhancedTimerReplicationProxy* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FEnhancedReplicatedTimerEntry, FEnhancedReplicatedTimerArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FEnhancedReplicatedTimerArray> : public TStructOpsTypeTraitsBase2<FEnhancedReplicatedTimerArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+/**
+ * Always-relevant actor that bridges server timers to clients.
+ * Spawned by the server subsystem when the first timer is made replicated;
+ * on clients it registers itself with the local subsystem on BeginPlay.
+ */
+UCLASS(NotPlaceable, Transient)
+class ENHANCEDTIMERMANAGER_API AEnhancedTimerReplicationProxy : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AEnhancedTimerReplicationProxy();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Current server world time as seen by this machine (synchronized through the GameState). */
+	double GetServerTime() const;
+
+	const FEnhancedReplicatedTimerEntry* FindEntry(FName Key) const;
+	const TArray<FEnhancedReplicatedTimerEntry>& GetEntries() const { return ReplicatedTimers.Items; }
+
+	// ===== Server only =====
+	FEnhancedReplicatedTimerEntry* FindEntryByTimerId(uint64 TimerId);
+	/** Add an entry that is not sent yet: fill it and call MarkEntryDirty (counted as one update). */
+	FEnhancedReplicatedTimerEntry& AddEntry(FName Key, uint64 TimerId);
+	void RemoveEntryAt(int32 Index);
+	void MarkEntryDirty(FEnhancedReplicatedTimerEntry& Entry) { ReplicatedTimers.MarkItemDirty(Entry); ++NumEntryUpdates; }
+	TArray<FEnhancedReplicatedTimerEntry>& GetMutableEntries() { return ReplicatedTimers.Items; }
+
+	/** Client-side notification from the fast array callbacks. */
+	void NotifyEntryChanged(const FEnhancedReplicatedTimerEntry& Entry, bool bRemoved);
+
+	/** Entry adds, changes and removes marked for sending (server) or received (client); flat while timers just run. */
+	int32 GetNumEntryUpdates() const { return NumEntryUpdates; }
+
+private:
+	int32 NumEntryUpdates = 0;
+
+	UPROPERTY(Replicated)
+	FEnhancedReplicatedTimerArray ReplicatedTimers;
+};
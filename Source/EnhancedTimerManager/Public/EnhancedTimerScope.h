@@ -0,0 +1,72 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimerManager.h"
+#include "EnhancedTimerManagerTypes.h"
+#include "EnhancedTimerHandle.h"
+
+class UEnhancedTimerManagerSubsystem;
+
+/**
+ * RAII owner for a set of timers created through it.
+ * All owned timers are invalidated in a single batched operation (one write lock)
+ * when the scope is reset or destroyed. Handles are stored inline for small counts.
+ *
+ * Typical use: keep one as a member of a component and call Reset() from EndPlay.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedTimerScope : public FNoncopyable
+{
+public:
+	/** Number of timers stored without a heap allocation. */
+	static constexpr int32 InlineCapacity = 16;
+
+	FEnhancedTimerScope() = default;
+	explicit FEnhancedTimerScope(UEnhancedTimerManagerSubsystem* InSubsystem);
+	~FEnhancedTimerScope();
+
+	FEnhancedTimerScope(FEnhancedTimerScope&& Other);
+	FEnhancedTimerScope& operator=(FEnhancedTimerScope&& Other);
+
+	/** Bind the scope to a subsystem. Timers owned through a previous subsystem are invalidated first. */
+	void SetSubsystem(UEnhancedTimerManagerSubsystem* InSubsystem);
+	UEnhancedTimerManagerSubsystem* GetSubsystem() const { return Subsystem.Get(); }
+
+	/** Same as UEnhancedTimerManagerSubsystem::SetEnhancedTimer, the timer is owned by this scope. */
+	FEnhancedTimerHandle SetEnhancedTimer(const FTimerDelegate& InDelegate,
+	                                      float Duration,
+	                                      EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+	                                      AActor* DilationActor = nullptr,
+	                                      bool bAffectedByGamePause = false,
+	                                      bool bLoop = false,
+	                                      float DelayToStartCountingDown = 0.f,
+	                                      float DelayToStartCountingDownVariation = 0.f,
+	                                      EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
+
+	/** Same as UEnhancedTimerManagerSubsystem::SetEnhancedTimerExecutedInNextTick, the timer is owned by this scope. */
+	FEnhancedTimerHandle SetEnhancedTimerExecutedInNextTick(const FTimerDelegate& InDelegate,
+	                                                        EEnhancedTimerTickGroup TickGroup = EEnhancedTimerTickGroup::Default);
+
+	/** Take ownership of a timer created elsewhere. Handles from another subsystem are ignored. */
+	void Add(const FEnhancedTimerHandle& Handle);
+
+	/** Stop owning a timer without invalidating it. */
+	void Release(const FEnhancedTimerHandle& Handle);
+
+	/** Invalidate every owned timer in one batched call and forget them. */
+	void Reset();
+
+	/** Forget handles whose timers already finished (one-shot timers that fired). */
+	void Compact();
+
+	/** Number of owned handles (including ones that may have already finished). */
+	int32 Num() const { return TimerIds.Num(); }
+	bool  IsEmpty() const { return TimerIds.Num() == 0; }
+
+private:
+	TWeakObjectPtr<UEnhancedTimerManagerSubsystem> Subsystem;
+	TArray<uint64, TInlineAllocator<InlineCapacity>> TimerIds;
+
+	void Track(const FEnhancedTimerHandle& Handle);
+};
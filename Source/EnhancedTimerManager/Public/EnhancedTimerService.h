@@ -0,0 +1,47 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UEnhancedTimerManagerSubsystem;
+
+/**
+ * Optional process-wide timer service for processes hosting several game instances (multi-session servers).
+ *
+ * Enabled with EnhancedTimers.SharedService=1 before the game instances start. Every subsystem then becomes
+ * a partition of the service: once per engine frame the service advances the Default-group timers of all
+ * non-idle partitions in parallel on worker threads, and each subsystem only fires its collected timers on
+ * the Game Thread in its own tick. Instances without timers cost nothing.
+ *
+ * The workers touch no UObject: dilation rates are resolved per domain on the Game Thread before the parallel
+ * pass, and the bookkeeping of timers the pass drops (cancelled tokens) is left to the Game Thread tick.
+ *
+ * Trade-off: a partition is advanced by the world delta of its previous tick, so timers fire up to one
+ * frame later than with the per-instance tick.
+ */
+class ENHANCEDTIMERMANAGER_API FEnhancedTimerService
+{
+public:
+	/** Value of EnhancedTimers.SharedService. */
+	static bool IsEnabled();
+
+	static FEnhancedTimerService& Get();
+
+	// ===== Game thread =====
+	void Register(UEnhancedTimerManagerSubsystem* Subsystem);
+	void Unregister(UEnhancedTimerManagerSubsystem* Subsystem);
+
+	int32 GetNumPartitions() const { return Partitions.Num(); }
+
+	/** Partitions advanced during the last service tick. */
+	int32 GetNumActivePartitionsLastTick() const { return ActivePartitions.Num(); }
+
+private:
+	bool Tick(float DeltaTime);
+
+	TArray<TWeakObjectPtr<UEnhancedTimerManagerSubsystem>> Partitions;   // subsystems leave in Deinitialize
+	TArray<UEnhancedTimerManagerSubsystem*> ActivePartitions;            // resolved for one tick, reused
+	FTSTicker::FDelegateHandle              TickerHandle;
+};
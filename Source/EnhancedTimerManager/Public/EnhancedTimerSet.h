@@ -0,0 +1,1255 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
+#include "Templates/Invoke.h"
+#include "Algo/Sort.h"
+#include "EnhancedTimerManagerTypes.h"
+#include "EnhancedTimerCancellationToken.h"
+#include "EnhancedTimerPagedStorage.h"
+#include "EnhancedChunkedArray.h"
+
+namespace EnhancedTimers
+{
+    /**
+     * Scale applied to the world delta for a dilation mode. Shared by every timer backend
+     * so that all of them follow the same dilation semantics.
+     */
+    FORCEINLINE float GetDilationScale(EEnhancedTimerTimeDilationMode Mode, const UWorld* World, const AActor* DilationActor)
+    {
+        switch (Mode)
+        {
+            case EEnhancedTimerTimeDilationMode::GlobalTimeDilation:
+                return World ? UGameplayStatics::GetGlobalTimeDilation(World) : 1.f;
+            case EEnhancedTimerTimeDilationMode::ActorTimeDilation:
+                // Fallback: actor invalid -> behave like IgnoreTimeDilation
+                return DilationActor ? FMath::Max(UE_SMALL_NUMBER, DilationActor->CustomTimeDilation) : 1.f;
+            default:
+                return 1.f;
+        }
+    }
+}
+
+/** Scheduling state of one timer (everything except its callback). */
+struct FEnhancedTimerState
+{
+    /** Phase machine to make initial delay deterministic and simple. */
+    enum class ETimerPhase : uint8
+    {
+        InitialDelay,
+        Running
+    };
+
+    bool                                   bLoop = false;
+    bool                                   bPaused = false;
+    bool                                   bAffectedByGamePause = false;
+    bool                                   bNextTick = false;
+
+    float                                  Duration = 0.f;       // seconds for Running phase
+    float                                  InitialDelay = 0.f;   // seconds for InitialDelay phase
+    float                                  NextMilestone = 0.f;  // time left at the next pending milestone of the Running phase (0 = none)
+    ETimerPhase                            Phase = ETimerPhase::Running;
+
+    EEnhancedTimerTimeDilationMode         DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
+    TWeakObjectPtr<AActor>                 DilationActor;
+    float                                  TimeScale = 1.f;      // timer seconds per domain second (on top of dilation)
+    int32                                  Priority = 0;         // higher fires first among timers due at the same instant
+    EEnhancedTimerPriorityClass            PriorityClass = EEnhancedTimerPriorityClass::Normal;  // interpreted by the owner
+
+    FEnhancedTimerCancellationToken        CancellationToken;    // optional shared cancel flag
+
+    // Owned by the container (deadline on the timer's domain clock, see FEnhancedTimerDomain)
+    double                                 PhaseStart = 0.0;     // domain time at which the current phase started
+    float                                  PausedElapsed = 0.f;  // phase time elapsed when paused
+    int32                                  DomainIndex = INDEX_NONE;
+    uint32                                 ScheduleSerial = 0;   // bumped on every (re)schedule; older heap entries are stale
+
+    /** True once the shared cancellation token (if any) has been cancelled. */
+    FORCEINLINE bool IsCancelled() const { return CancellationToken.IsCancelled(); }
+
+    /** Compute effective delta time considering dilation mode and the timer's own time scale. */
+    FORCEINLINE float GetEffectiveDelta(float WorldDelta, const UWorld* World) const
+    {
+        return WorldDelta * EnhancedTimers::GetDilationScale(DilationMode, World, DilationActor.Get()) * TimeScale;
+    }
+
+    /** Length of the current phase. */
+    FORCEINLINE float GetPhaseLength() const { return Phase == ETimerPhase::InitialDelay ? InitialDelay : Duration; }
+
+    /** Set up a countdown (InitialDelay > 0 starts in the InitialDelay phase). */
+    FORCEINLINE void Arm(float InDuration, bool bInLoop, float InInitialDelay = 0.f)
+    {
+        Duration     = FMath::Max(0.f, InDuration);
+        bLoop        = bInLoop;
+        bNextTick    = false;
+        InitialDelay = FMath::Max(0.f, InInitialDelay);
+        Phase        = InitialDelay > 0.f ? ETimerPhase::InitialDelay : ETimerPhase::Running;
+    }
+};
+
+/**
+ * Timers sharing a dilation source and game-pause behaviour share one clock.
+ * A frame only advances the clocks of the domains; timers hold absolute deadlines on their domain clock
+ * and are not written again until they fire, pause or get re-armed.
+ */
+struct FEnhancedTimerDomainKey
+{
+    EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
+    TWeakObjectPtr<AActor>         Actor;                // ActorTimeDilation only
+    bool                           bTicksWhenPaused = false;
+
+    bool operator==(const FEnhancedTimerDomainKey& Other) const
+    {
+        return DilationMode == Other.DilationMode && Actor == Other.Actor && bTicksWhenPaused == Other.bTicksWhenPaused;
+    }
+
+    friend uint32 GetTypeHash(const FEnhancedTimerDomainKey& Key)
+    {
+        return HashCombine(GetTypeHash(Key.Actor), ((uint32)Key.DilationMode << 1) | (Key.bTicksWhenPaused ? 1u : 0u));
+    }
+};
+
+/** Deadline heap entry (lazy deletion: stale when the serial no longer matches the timer). */
+struct FEnhancedTimerHeapEntry
+{
+    double Deadline = 0.0;
+    uint64 Id = 0;
+    uint32 Serial = 0;
+
+    FORCEINLINE bool operator<(const FEnhancedTimerHeapEntry& Other) const
+    {
+        return Deadline != Other.Deadline ? Deadline < Other.Deadline : Id < Other.Id;
+    }
+};
+
+/** Structure holding the pending deadlines of a domain. */
+enum class EEnhancedTimerEngine : uint8
+{
+    Heap,    // binary min-heap: sparse or long timers
+    Scan,    // unsorted array scanned every frame: a handful of timers
+    Wheel,   // timing wheel for deadlines within the wheel span (heap beyond it): many short timers, high churn
+};
+
+/** Workload of a domain measured over the last evaluation window. */
+struct FEnhancedTimerWorkload
+{
+    int32 NumTimers = 0;
+    float ShortFraction = 0.f;    // share of scheduled deadlines that fell within the wheel span
+    float MeanInterval = 0.f;     // mean scheduled interval (domain seconds)
+    float ChurnPerSecond = 0.f;   // schedules + removals per domain second
+};
+
+/** How a set picks the engine of its domains. */
+struct FEnhancedTimerEngineSettings
+{
+    bool                 bAdaptive = true;
+    EEnhancedTimerEngine ForcedEngine = EEnhancedTimerEngine::Heap;   // used when !bAdaptive
+
+    float EvaluationPeriod = 1.f;          // domain seconds between decisions
+    int32 ScanMaxTimers = 64;
+    int32 WheelMinTimers = 1024;
+    float WheelMinChurnPerSecond = 2000.f;
+    float WheelMinShortFraction = 0.75f;
+
+    bool operator==(const FEnhancedTimerEngineSettings& Other) const
+    {
+        return bAdaptive == Other.bAdaptive && ForcedEngine == Other.ForcedEngine && EvaluationPeriod == Other.EvaluationPeriod
+            && ScanMaxTimers == Other.ScanMaxTimers && WheelMinTimers == Other.WheelMinTimers
+            && WheelMinChurnPerSecond == Other.WheelMinChurnPerSecond && WheelMinShortFraction == Other.WheelMinShortFraction;
+    }
+    bool operator!=(const FEnhancedTimerEngineSettings& Other) const { return !(*this == Other); }
+
+    /** Few timers: scan. Many short timers or heavy churn of short timers: wheel. Otherwise: heap. */
+    EEnhancedTimerEngine Choose(const FEnhancedTimerWorkload& Workload) const
+    {
+        if (Workload.NumTimers <= ScanMaxTimers) return EEnhancedTimerEngine::Scan;
+        if (Workload.ShortFraction >= WheelMinShortFraction
+            && (Workload.NumTimers >= WheelMinTimers || Workload.ChurnPerSecond >= WheelMinChurnPerSecond))
+        {
+            return EEnhancedTimerEngine::Wheel;
+        }
+        return EEnhancedTimerEngine::Heap;
+    }
+};
+
+inline const TCHAR* LexToString(EEnhancedTimerEngine Engine)
+{
+    switch (Engine)
+    {
+        case EEnhancedTimerEngine::Scan:  return TEXT("Scan");
+        case EEnhancedTimerEngine::Wheel: return TEXT("Wheel");
+        default:                          return TEXT("Heap");
+    }
+}
+
+struct FEnhancedTimerDomain
+{
+    FEnhancedTimerDomainKey          Key;
+    double                           Time = 0.0;         // domain clock (timer seconds)
+    float                            LastDelta = 0.f;    // clock advance of the last Advance
+    int32                            NumTimers = 0;
+    int32                            NumClockRefs = 0;   // AcquireClock users; keeps the domain (and its time) alive
+
+    EEnhancedTimerEngine             Engine = EEnhancedTimerEngine::Heap;
+    TEnhancedChunkedArray<FEnhancedTimerHeapEntry> Heap; // Heap: min-heap; Scan: unsorted; Wheel: min-heap beyond the wheel span
+    TArray<TArray<FEnhancedTimerHeapEntry>> WheelSlots;  // Wheel only
+    int64                            WheelTick = 0;      // Wheel: first slot tick not fully processed
+
+    // Workload of the current evaluation window
+    double                           WindowStart = 0.0;
+    double                           WindowIntervalSum = 0.0;
+    int32                            WindowScheduled = 0;
+    int32                            WindowShort = 0;
+    int32                            WindowRemoved = 0;
+    FEnhancedTimerWorkload           Workload;           // last completed window
+    EEnhancedTimerEngine             Candidate = EEnhancedTimerEngine::Heap;
+    int32                            CandidateVotes = 0;
+};
+
+/**
+ * A timer that became due during the current tick, with its ordering key.
+ * Fired timers run in (FireFraction, -Priority, Sequence) order: earliest crossing within the frame first,
+ * then higher priority, then creation order.
+ * Only the fired set is sorted, never the whole timer storage.
+ */
+struct FEnhancedFiredTimer
+{
+    uint64 Id = 0;
+    float  FireFraction = 0.f;   // 0 = due at the start of the frame, 1 = due at the end
+    int32  Priority = 0;
+    uint64 Sequence = 0;         // creation order within the set
+    int32  Milestone = INDEX_NONE;   // index of the crossed milestone; INDEX_NONE = the timer itself fired
+
+    FORCEINLINE bool operator<(const FEnhancedFiredTimer& Other) const
+    {
+        if (FireFraction != Other.FireFraction) return FireFraction < Other.FireFraction;
+        if (Priority != Other.Priority)         return Priority > Other.Priority;
+        if (Sequence != Other.Sequence)         return Sequence < Other.Sequence;
+        return (uint32)Milestone < (uint32)Other.Milestone;   // milestones in order, the fire itself last
+    }
+};
+
+/**
+ * Embeddable timer container with the scheduling rules of UEnhancedTimerManagerSubsystem
+ * (initial delay phase, loop, pause, game pause gate, dilation, time scale, priority, cancellation tokens).
+ *
+ * The set does no locking and is not thread-safe: it is meant to be owned by one system and ticked
+ * from that system's own update loop, e.g.
+ *
+ *     TEnhancedTimerSet<TFunction<void()>> Timers;
+ *     const uint64 Id = Timers.Add([this]() { Refill(); }, 2.f, true);
+ *     Timers.Tick(DeltaTime, GetWorld(), UGameplayStatics::IsGamePaused(this));
+ *
+ * Layout: timers are grouped into domains (dilation source + game pause behaviour). A tick advances one clock
+ * per domain and collects due deadlines from the domain's engine, so the cost of a frame scales with the number
+ * of domains and fired timers, and timer entries are only written when they fire, pause or are re-armed. This
+ * also keeps memory shared after fork() (pre-forked servers) from being copied by the per-frame update.
+ *
+ * Engines: each domain keeps its deadlines in a heap, a scanned array (few timers) or a timing wheel (many short
+ * timers). With adaptive settings (default) the set measures count, interval distribution and churn per domain
+ * and migrates the deadlines between engines at the start of the domain's Advance; Ids never change.
+ *
+ * Milestones: a timer may carry remaining-time thresholds ("10 s left", "5 s left", ...). The next pending milestone
+ * is the timer's scheduled deadline, so one entry replaces a timer per threshold; crossings are reported by Advance
+ * as fired entries with a Milestone index and do not complete the timer.
+ *
+ * Storage: timers live in TEnhancedPagedStorage pages, so adding timers never moves existing ones (no rehash
+ * spike when the count crosses a power of two) and pointers returned by Find stay valid until the timer is
+ * removed. Ids are allocated by the set (0 == invalid); owners may put a small tag in the low bits of the Ids
+ * through Emplace (the subsystem stores the tick group there).
+ *
+ * Scheduling fields of FEnhancedTimerState (phase, durations, pause, dilation, time scale) are owned by the set: change
+ * them through the set, not through Find. CallbackType must be invocable with no arguments. Tick runs
+ * everything; Advance + CompleteFired are the split form for owners that fire outside a lock.
+ */
+template<typename CallbackType>
+class TEnhancedTimerSet
+{
+public:
+    struct FTimer : public FEnhancedTimerState
+    {
+        uint64       Id = 0;
+        uint64       Sequence = 0;     // creation order (tie-break of the fire order)
+        CallbackType Callback;
+    };
+
+    using FStorage = TEnhancedPagedStorage<FTimer>;
+
+    TEnhancedTimerSet() = default;
+    TEnhancedTimerSet(const TEnhancedTimerSet&) = delete;
+    TEnhancedTimerSet& operator=(const TEnhancedTimerSet&) = delete;
+
+    /** Create a countdown. Returns the timer Id. */
+    uint64 Add(CallbackType&& Callback,
+               float Duration,
+               bool bLoop = false,
+               EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+               AActor* DilationActor = nullptr,
+               bool bAffectedByGamePause = false,
+               float InitialDelay = 0.f)
+    {
+        FTimer Timer;
+        Timer.Callback             = MoveTemp(Callback);
+        Timer.DilationMode         = DilationMode;
+        Timer.DilationActor        = DilationActor;
+        Timer.bAffectedByGamePause = bAffectedByGamePause;
+        Timer.Arm(Duration, bLoop, InitialDelay);
+        return Emplace(MoveTemp(Timer)).Id;
+    }
+
+    /** Fire once on the next Tick, even during game pause. */
+    uint64 AddNextTick(CallbackType&& Callback)
+    {
+        FTimer Timer;
+        Timer.Callback             = MoveTemp(Callback);
+        Timer.bAffectedByGamePause = true;
+        Timer.bNextTick            = true;
+        return Emplace(MoveTemp(Timer)).Id;
+    }
+
+    /**
+     * Insert a timer set up by the caller (configuration, Phase), assign its Id and start its current phase now.
+     * Tag (0..FStorage::MaxTag) is stored in the low bits of the Id.
+     * ClockLag: owner time that already passed but will only be delivered by the next Tick (owners that
+     * tick irregularly); the phase starts after it.
+     */
+    FTimer& Emplace(FTimer&& Timer, float ClockLag = 0.f, uint32 Tag = 0)
+    {
+        uint64 Id = 0;
+        FTimer& T = Timers.Add(MoveTemp(Timer), Tag, Id);
+        T.Id       = Id;
+        T.Sequence = NextSequence++;
+
+        T.DomainIndex = FindOrAddDomain(T);
+        FEnhancedTimerDomain& Domain = Domains[T.DomainIndex];
+        ++Domain.NumTimers;
+
+        T.PhaseStart    = Domain.Time + FMath::Max(0.f, ClockLag);
+        T.PausedElapsed = 0.f;
+        Schedule(T);
+        return T;
+    }
+
+    bool Remove(uint64 Id)
+    {
+        FTimer* T = Timers.Find(Id);
+        if (!T) return false;
+
+        if (OnRemoved) OnRemoved(*T);
+        if (Milestones.Num() > 0) Milestones.Remove(Id);
+
+        // Scheduled entries of the timer become stale; empty domains are released by the next Advance.
+        FEnhancedTimerDomain& Domain = Domains[T->DomainIndex];
+        --Domain.NumTimers;
+        ++Domain.WindowRemoved;
+        return Timers.Remove(Id);
+    }
+
+    /** Remove every timer. Clocks held through AcquireClock keep running. */
+    void Reset()
+    {
+        Timers.Reset();
+        Milestones.Reset();
+        ResetDomains();
+    }
+
+    void Empty()
+    {
+        Timers.Empty();
+        Milestones.Empty();
+        ResetDomains();
+        if (Domains.Num() == 0)
+        {
+            Domains.Empty();
+            DomainLookup.Empty();
+        }
+    }
+
+    /**
+     * Keep the clock of a domain alive without a timer in it, e.g. to compute elapsed time lazily against it.
+     * Returns a clock index for GetClockTime; pair with ReleaseClock.
+     */
+    int32 AcquireClock(EEnhancedTimerTimeDilationMode DilationMode, AActor* DilationActor, bool bTicksWhenPaused)
+    {
+        FEnhancedTimerState State;
+        State.DilationMode         = DilationMode;
+        State.DilationActor        = DilationActor;
+        State.bAffectedByGamePause = bTicksWhenPaused;
+
+        const int32 Index = FindOrAddDomain(State);
+        ++Domains[Index].NumClockRefs;
+        return Index;
+    }
+
+    void ReleaseClock(int32 ClockIndex)
+    {
+        if (Domains.IsValidIndex(ClockIndex))
+        {
+            Domains[ClockIndex].NumClockRefs = FMath::Max(0, Domains[ClockIndex].NumClockRefs - 1);
+        }
+    }
+
+    /** Domain time of a clock from AcquireClock (timer seconds, the unit of every duration in its domain). */
+    double GetClockTime(int32 ClockIndex) const
+    {
+        return Domains.IsValidIndex(ClockIndex) ? Domains[ClockIndex].Time : 0.0;
+    }
+
+    /** Allocate storage pages for Number timers up front. */
+    void Reserve(int32 Number) { Timers.Reserve(Number); }
+
+    FTimer*       Find(uint64 Id)       { return Timers.Find(Id); }
+    const FTimer* Find(uint64 Id) const { return Timers.Find(Id); }
+
+    /** Alive and not cancelled through its token. */
+    bool IsValid(uint64 Id) const
+    {
+        const FTimer* Timer = Timers.Find(Id);
+        return Timer && !Timer->IsCancelled();
+    }
+
+    int32 Num() const { return Timers.Num(); }
+    bool  IsEmpty() const { return Timers.Num() == 0; }
+
+    /** True while an Advance has work: timers, or clocks held through AcquireClock (which keep running without timers). */
+    bool HasActiveDomains() const
+    {
+        for (const FEnhancedTimerDomain& Domain : Domains)
+        {
+            if (Domain.NumTimers > 0 || Domain.NumClockRefs > 0) return true;
+        }
+        return false;
+    }
+    int32 NumDomains() const { return Domains.Num(); }
+
+    /** Time elapsed in the timer's current phase. */
+    float GetPhaseElapsed(const FTimer& T) const
+    {
+        if (T.bPaused) return T.PausedElapsed;
+        return (float)FMath::Max(0.0, (Domains[T.DomainIndex].Time - T.PhaseStart) * T.TimeScale);
+    }
+
+    /** Time left in the current phase. */
+    float GetTimeLeft(const FTimer& T) const
+    {
+        return FMath::Max(0.f, T.GetPhaseLength() - GetPhaseElapsed(T));
+    }
+
+    /** Timer time until the next fire, including any remaining initial delay. */
+    float GetTimeUntilFire(const FTimer& T) const
+    {
+        const float Left = GetTimeLeft(T);
+        return T.Phase == FEnhancedTimerState::ETimerPhase::InitialDelay ? Left + T.Duration : Left;
+    }
+
+    /**
+     * Lower bound of the domain time until the next deadline (removed timers may make it early),
+     * MAX_flt when nothing is scheduled. Lets owners bound how long they wait before the next Tick.
+     */
+    float GetTimeUntilNextDue() const
+    {
+        double Min = MAX_dbl;
+        for (const FEnhancedTimerDomain& Domain : Domains)
+        {
+            if (Domain.NumTimers > 0)
+            {
+                Min = FMath::Min(Min, GetEarliestDeadline(Domain) - Domain.Time);
+            }
+        }
+        return Min == MAX_dbl ? MAX_flt : (float)FMath::Max(0.0, Min);
+    }
+
+    /**
+     * Histogram of upcoming fires: OutCounts[i] receives the number of fires expected in [i, i + 1) * BucketSeconds
+     * of tick delta from now, assuming dilation stays as it is. Looping timers count once per period; domains
+     * frozen by bGamePaused are left out. Deadline heaps are only walked down to the horizon (an entry never
+     * precedes its parent) and wheels only up to it, so the cost scales with the timers due within the forecast.
+     */
+    void Forecast(float BucketSeconds, int32 NumBuckets, const UWorld* World, bool bGamePaused, TArray<int32>& OutCounts) const
+    {
+        OutCounts.Reset(NumBuckets);
+        OutCounts.AddZeroed(FMath::Max(0, NumBuckets));
+        if (BucketSeconds <= 0.f || NumBuckets <= 0) return;
+
+        const double Horizon = (double)BucketSeconds * NumBuckets;
+        auto AddFire = [&OutCounts, BucketSeconds, NumBuckets](double Seconds)
+        {
+            const int32 Bucket = (int32)(Seconds / BucketSeconds);
+            if (Bucket < NumBuckets) ++OutCounts[Bucket];
+        };
+
+        for (const FEnhancedTimerDomain& Domain : Domains)
+        {
+            if (Domain.NumTimers == 0) continue;
+            if (bGamePaused && !Domain.Key.bTicksWhenPaused) continue;
+
+            // Domain seconds per second of tick delta.
+            const double Rate = EnhancedTimers::GetDilationScale(Domain.Key.DilationMode, World, Domain.Key.Actor.Get());
+
+            ForEachEntryBefore(Domain, Domain.Time + Horizon * Rate, [&](const FEnhancedTimerHeapEntry& Entry)
+            {
+                const FTimer* T = Timers.Find(Entry.Id);
+                if (!T || T->ScheduleSerial != Entry.Serial || T->IsCancelled()) return;
+
+                if (T->bNextTick)
+                {
+                    AddFire(0.0);
+                    return;
+                }
+
+                // The deadline of an initial delay is the phase transition; the first fire is one Duration later.
+                const double Period = (double)T->Duration / T->TimeScale / Rate;
+                double Fire = FMath::Max(0.0, Entry.Deadline - Domain.Time) / Rate;
+                if (T->Phase == FEnhancedTimerState::ETimerPhase::InitialDelay)
+                {
+                    Fire += Period;
+                }
+                else
+                {
+                    // A pending milestone is scheduled ahead of the fire by its time left.
+                    Fire += (double)T->NextMilestone / T->TimeScale / Rate;
+                }
+
+                for (; Fire < Horizon; Fire += Period)
+                {
+                    AddFire(Fire);
+                    if (!T->bLoop || Period <= UE_KINDA_SMALL_NUMBER) break;
+                }
+            });
+        }
+    }
+
+    void SetPaused(uint64 Id, bool bPaused)
+    {
+        if (FTimer* T = Timers.Find(Id))
+        {
+            SetPaused(*T, bPaused);
+        }
+    }
+
+    void SetAllPaused(bool bPaused)
+    {
+        Timers.ForEach([this, bPaused](FTimer& T) { SetPaused(T, bPaused); });
+    }
+
+    /**
+     * Change how fast the timer runs relative to its domain clock (1 = normal). The phase keeps its elapsed
+     * time and only the pending deadline is moved.
+     */
+    void SetTimeScale(uint64 Id, float TimeScale)
+    {
+        if (FTimer* T = Timers.Find(Id))
+        {
+            SetTimeScale(*T, TimeScale);
+        }
+    }
+
+    void SetTimeScale(FTimer& T, float TimeScale)
+    {
+        TimeScale = FMath::Max(UE_SMALL_NUMBER, TimeScale);
+        if (T.TimeScale == TimeScale) return;
+
+        if (T.bPaused || T.bNextTick)
+        {
+            T.TimeScale = TimeScale;    // picked up when the deadline is scheduled again
+            return;
+        }
+
+        const float Elapsed = GetPhaseElapsed(T);
+        T.TimeScale  = TimeScale;
+        T.PhaseStart = Domains[T.DomainIndex].Time - Elapsed / TimeScale;
+        Schedule(T);
+    }
+
+    /**
+     * Change the Running-phase length of a timer (the period of a loop). A Running phase keeps its elapsed time
+     * and moves its pending deadline; an initial delay uses the new length once it ends. Returns false if unknown.
+     */
+    bool SetLoopDuration(uint64 Id, float NewDuration)
+    {
+        FTimer* T = Timers.Find(Id);
+        if (!T) return false;
+
+        NewDuration = FMath::Max(0.f, NewDuration);
+        if (T->Duration == NewDuration) return true;
+
+        T->Duration = NewDuration;
+        if (T->Phase == FEnhancedTimerState::ETimerPhase::Running && !T->bNextTick)
+        {
+            ArmMilestones(*T, GetTimeLeft(*T));
+            Schedule(*T);
+        }
+        return true;
+    }
+
+    /**
+     * Replace the milestones of a timer. TimesRemaining: positive thresholds of time left in the Running phase, largest
+     * first; the index of a threshold is the Milestone reported when it is crossed. Thresholds the current
+     * phase already passed are skipped; looping timers cross them again every period. Empty clears.
+     */
+    void SetMilestones(uint64 Id, TConstArrayView<float> TimesRemaining)
+    {
+        FTimer* T = Timers.Find(Id);
+        if (!T) return;
+
+        if (TimesRemaining.Num() == 0)
+        {
+            Milestones.Remove(Id);
+        }
+        else
+        {
+            FMilestoneList& List = Milestones.FindOrAdd(Id);
+            List.TimesRemaining.Reset(TimesRemaining.Num());
+            List.TimesRemaining.Append(TimesRemaining.GetData(), TimesRemaining.Num());
+        }
+        ArmMilestones(*T, T->Phase == FEnhancedTimerState::ETimerPhase::Running && !T->bNextTick ? GetTimeLeft(*T) : T->Duration);
+        if (!T->bNextTick)
+        {
+            Schedule(*T);
+        }
+    }
+
+    /** Thresholds set through SetMilestones (empty if none). */
+    TConstArrayView<float> GetMilestones(uint64 Id) const
+    {
+        const FMilestoneList* List = Milestones.Find(Id);
+        return List ? TConstArrayView<float>(List->TimesRemaining) : TConstArrayView<float>();
+    }
+
+    /** Called by Tick for every milestone crossing (Advance + CompleteFired owners handle Milestone entries themselves). */
+    void SetOnMilestone(TFunction<void(const FTimer& /*Timer*/, int32 /*Milestone*/)>&& InOnMilestone) { OnMilestone = MoveTemp(InOnMilestone); }
+
+    /** Engine selection of the domains; forced engines are applied at the next Advance. */
+    void SetEngineSettings(const FEnhancedTimerEngineSettings& InSettings) { EngineSettings = InSettings; }
+    const FEnhancedTimerEngineSettings& GetEngineSettings() const { return EngineSettings; }
+
+    /** Called after a domain moved to another engine (Domain.Workload holds the statistics behind the decision). */
+    void SetOnEngineSwitched(TFunction<void(const FEnhancedTimerDomain& /*Domain*/, EEnhancedTimerEngine /*OldEngine*/)>&& InOnEngineSwitched)
+    {
+        OnEngineSwitched = MoveTemp(InOnEngineSwitched);
+    }
+
+    template<typename FuncType>
+    void ForEachDomain(FuncType&& Func) const
+    {
+        for (const FEnhancedTimerDomain& Domain : Domains)
+        {
+            Func(Domain);
+        }
+    }
+
+    /** Called with every timer that leaves the set one by one (Remove, completion, token drop); not on Reset/Empty. */
+    void SetOnRemoved(TFunction<void(const FTimer&)>&& InOnRemoved) { OnRemoved = MoveTemp(InOnRemoved); }
+
+    template<typename FuncType>
+    void ForEach(FuncType&& Func) const
+    {
+        Timers.ForEach(Forward<FuncType>(Func));
+    }
+
+    template<typename FuncType>
+    void ForEachMutable(FuncType&& Func)
+    {
+        Timers.ForEach(Forward<FuncType>(Func));
+    }
+
+    /**
+     * Dilation rate of every domain (domain seconds per second of world delta), indexed by domain index.
+     * Reads the world and the dilation actors, so it must run on the Game Thread.
+     */
+    void ResolveDomainRates(const UWorld* World, TArray<float>& OutRates) const
+    {
+        OutRates.Reset(Domains.GetMaxIndex());
+        OutRates.AddUninitialized(Domains.GetMaxIndex());
+        for (typename TSparseArray<FEnhancedTimerDomain>::TConstIterator It(Domains); It; ++It)
+        {
+            OutRates[It.GetIndex()] = EnhancedTimers::GetDilationScale(It->Key.DilationMode, World, It->Key.Actor.Get());
+        }
+    }
+
+    /**
+     * Advance every domain clock and append the timers that became due to OutFired, in fire order.
+     * Cancelled timers are dropped when they surface. Returns the number of scheduled entries visited.
+     */
+    int32 Advance(float DeltaTime, const UWorld* World, bool bGamePaused, TArray<FEnhancedFiredTimer>& OutFired)
+    {
+        ResolveDomainRates(World, Rates);
+        return Advance(DeltaTime, Rates, bGamePaused, OutFired);
+    }
+
+    /**
+     * Advance with rates from ResolveDomainRates. Touches no UObject, so an owner may run it on a worker
+     * (OnRemoved and OnEngineSwitched are then called on that worker). Domains added after the rates were
+     * resolved are not advanced.
+     */
+    int32 Advance(float DeltaTime, TConstArrayView<float> DomainRates, bool bGamePaused, TArray<FEnhancedFiredTimer>& OutFired)
+    {
+        const int32 FirstFired = OutFired.Num();
+        int32 NumVisited = 0;
+
+        for (typename TSparseArray<FEnhancedTimerDomain>::TIterator It(Domains); It; ++It)
+        {
+            FEnhancedTimerDomain& Domain = *It;
+            Domain.LastDelta = 0.f;
+
+            if (Domain.NumTimers == 0 && Domain.NumClockRefs == 0)
+            {
+                DomainLookup.Remove(Domain.Key);
+                It.RemoveCurrent();
+                continue;
+            }
+            if (bGamePaused && !Domain.Key.bTicksWhenPaused) continue;
+            if (!DomainRates.IsValidIndex(It.GetIndex())) continue;
+
+            // Safe point: nothing of this domain is being fired, so its deadlines may move to another engine.
+            UpdateEngine(Domain);
+
+            // One dilation lookup per domain and frame.
+            const float Eff = DeltaTime * DomainRates[It.GetIndex()];
+            Domain.Time     += Eff;
+            Domain.LastDelta = Eff;
+
+            Transitioned.Reset();
+            NumVisited += CollectDue(Domain, Domain.Time + KINDA_SMALL_NUMBER, [&](const FEnhancedTimerHeapEntry& Entry)
+            {
+                FTimer* T = Timers.Find(Entry.Id);
+                if (!T || T->ScheduleSerial != Entry.Serial) return;
+
+                // Cancelled through a shared token: drop lazily now that the timer surfaced.
+                if (T->IsCancelled())
+                {
+                    Remove(Entry.Id);
+                    return;
+                }
+
+                if (T->bNextTick)
+                {
+                    // Next-tick timers are due at the very start of the frame.
+                    OutFired.Add({ T->Id, 0.f, T->Priority, T->Sequence });
+                    return;
+                }
+
+                if (T->Phase == FEnhancedTimerState::ETimerPhase::InitialDelay)
+                {
+                    // Transition to Running; do not fire on transition (the Running phase starts counting next frame).
+                    T->Phase      = FEnhancedTimerState::ETimerPhase::Running;
+                    T->PhaseStart = Domain.Time;
+                    Transitioned.Add(T->Id);
+                    return;
+                }
+
+                // Fraction of this frame at which a deadline was crossed (overshoot measured in the timer's own time).
+                auto GetFraction = [&Domain, Eff](double Deadline)
+                {
+                    const double Overshoot = FMath::Max(0.0, Domain.Time - Deadline);
+                    return Eff > 0.f ? FMath::Clamp(1.f - (float)(Overshoot / Eff), 0.f, 1.f) : 0.f;
+                };
+
+                if (T->NextMilestone > 0.f)
+                {
+                    // Report every milestone crossed this frame; reschedule unless the phase end was crossed as well.
+                    FMilestoneList& List = Milestones.FindChecked(T->Id);
+                    const double End = T->PhaseStart + T->Duration / T->TimeScale;
+                    while (List.Next < List.TimesRemaining.Num())
+                    {
+                        const double At = End - List.TimesRemaining[List.Next] / T->TimeScale;
+                        if (At > Domain.Time + KINDA_SMALL_NUMBER) break;
+                        OutFired.Add({ T->Id, GetFraction(At), T->Priority, T->Sequence, List.Next });
+                        ++List.Next;
+                    }
+                    T->NextMilestone = List.Next < List.TimesRemaining.Num() ? List.TimesRemaining[List.Next] : 0.f;
+
+                    if (End > Domain.Time + KINDA_SMALL_NUMBER)
+                    {
+                        Transitioned.Add(T->Id);
+                        return;
+                    }
+                    OutFired.Add({ T->Id, GetFraction(End), T->Priority, T->Sequence });
+                    return;
+                }
+
+                OutFired.Add({ T->Id, GetFraction(Entry.Deadline), T->Priority, T->Sequence });
+            });
+
+            for (uint64 Id : Transitioned)
+            {
+                FTimer* T = Timers.Find(Id);
+                check(T);
+                Schedule(*T);
+            }
+        }
+
+        // Deterministic order independent of map layout: sort only what fired this frame.
+        if (OutFired.Num() - FirstFired > 1)
+        {
+            Algo::Sort(MakeArrayView(OutFired.GetData() + FirstFired, OutFired.Num() - FirstFired));
+        }
+        return NumVisited;
+    }
+
+    /** After a fired callback ran: re-arm a looping timer or remove a one-shot. Returns true if the timer lives on. */
+    bool CompleteFired(uint64 Id)
+    {
+        FTimer* T = Timers.Find(Id);
+        if (!T) return false;
+
+        if (T->bLoop && !T->IsCancelled() && !T->bNextTick)
+        {
+            // Restart the Running phase from now (overshoot is not carried over).
+            T->Phase         = FEnhancedTimerState::ETimerPhase::Running;
+            T->PhaseStart    = Domains[T->DomainIndex].Time;
+            T->PausedElapsed = 0.f;
+            ArmMilestones(*T, T->Duration);
+            Schedule(*T);
+            return true;
+        }
+        Remove(Id);
+        return false;
+    }
+
+    /**
+     * Advance and fire due timers. Callbacks may add, remove, pause or re-arm timers of this set
+     * (but must not Tick it). Returns the number of callbacks executed.
+     */
+    int32 Tick(float DeltaTime, const UWorld* World = nullptr, bool bGamePaused = false)
+    {
+        checkf(!bTicking, TEXT("TEnhancedTimerSet::Tick is not reentrant"));
+        TGuardValue<bool> TickGuard(bTicking, true);
+
+        Fired.Reset();
+        Advance(DeltaTime, World, bGamePaused, Fired);
+
+        int32 NumExecuted = 0;
+        for (const FEnhancedFiredTimer& Entry : Fired)
+        {
+            FTimer* T = Timers.Find(Entry.Id);
+            if (!T) continue;
+
+            // Token may have been cancelled by a callback that ran earlier this tick.
+            if (T->IsCancelled())
+            {
+                Remove(Entry.Id);
+                continue;
+            }
+
+            if (Entry.Milestone != INDEX_NONE)
+            {
+                if (OnMilestone)
+                {
+                    OnMilestone(*T, Entry.Milestone);
+                    ++NumExecuted;
+                }
+                continue;
+            }
+
+            // Move the callback out: the timer may be removed (and its slot reused) by the callback.
+            CallbackType Callback = MoveTemp(T->Callback);
+            Invoke(Callback);
+            ++NumExecuted;
+
+            if (FTimer* After = Timers.Find(Entry.Id))
+            {
+                After->Callback = MoveTemp(Callback);
+                CompleteFired(Entry.Id);
+            }
+        }
+        return NumExecuted;
+    }
+
+    /** Wheel geometry: one slot per 1/60 s of domain time, 256 slots (~4.3 s span). */
+    static constexpr double WheelSlotSeconds = 1.0 / 60.0;
+    static constexpr int32  NumWheelSlots    = 256;
+    static constexpr double WheelSpan        = WheelSlotSeconds * NumWheelSlots;
+
+private:
+    /** Drop every domain except the ones whose clock is held, which only lose their schedule. */
+    void ResetDomains()
+    {
+        for (typename TSparseArray<FEnhancedTimerDomain>::TIterator It(Domains); It; ++It)
+        {
+            FEnhancedTimerDomain& Domain = *It;
+            if (Domain.NumClockRefs > 0)
+            {
+                Domain.NumTimers = 0;
+                Domain.Heap.Reset();
+                for (TArray<FEnhancedTimerHeapEntry>& Slot : Domain.WheelSlots) Slot.Reset();
+            }
+            else
+            {
+                DomainLookup.Remove(Domain.Key);
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    int32 FindOrAddDomain(const FEnhancedTimerState& T)
+    {
+        FEnhancedTimerDomainKey Key;
+        Key.DilationMode     = T.DilationMode;
+        Key.Actor            = T.DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation ? T.DilationActor : TWeakObjectPtr<AActor>();
+        Key.bTicksWhenPaused = T.bAffectedByGamePause;
+
+        if (const int32* Found = DomainLookup.Find(Key))
+        {
+            return *Found;
+        }
+
+        FEnhancedTimerDomain Domain;
+        Domain.Key = Key;
+        const int32 Index = Domains.Add(MoveTemp(Domain));
+        DomainLookup.Add(Key, Index);
+        return Index;
+    }
+
+    /** Point the timer at its first milestone still ahead of TimeLeft (time left in the Running phase). */
+    void ArmMilestones(FTimer& T, float TimeLeft)
+    {
+        T.NextMilestone = 0.f;
+        if (Milestones.Num() == 0) return;
+
+        if (FMilestoneList* List = Milestones.Find(T.Id))
+        {
+            List->Next = 0;
+            while (List->Next < List->TimesRemaining.Num() && List->TimesRemaining[List->Next] >= TimeLeft)
+            {
+                ++List->Next;
+            }
+            T.NextMilestone = List->Next < List->TimesRemaining.Num() ? List->TimesRemaining[List->Next] : 0.f;
+        }
+    }
+
+    /** Push the deadline of the current phase, or of its next milestone (paused timers are scheduled again on unpause). */
+    void Schedule(FTimer& T)
+    {
+        ++T.ScheduleSerial;
+        if (T.bPaused) return;
+
+        FEnhancedTimerDomain& Domain = Domains[T.DomainIndex];
+        const float  Milestone = T.Phase == FEnhancedTimerState::ETimerPhase::Running ? T.NextMilestone : 0.f;
+        const double Deadline  = T.bNextTick ? Domain.Time : T.PhaseStart + (T.GetPhaseLength() - Milestone) / T.TimeScale;
+        PushEntry(Domain, { Deadline, T.Id, T.ScheduleSerial });
+
+        const double Interval = FMath::Max(0.0, Deadline - Domain.Time);
+        ++Domain.WindowScheduled;
+        Domain.WindowShort       += Interval < WheelSpan ? 1 : 0;
+        Domain.WindowIntervalSum += Interval;
+    }
+
+    static FORCEINLINE int64 GetWheelTick(double Time) { return (int64)FMath::FloorToDouble(Time / WheelSlotSeconds); }
+
+    void PushEntry(FEnhancedTimerDomain& Domain, const FEnhancedTimerHeapEntry& Entry)
+    {
+        switch (Domain.Engine)
+        {
+            case EEnhancedTimerEngine::Scan:
+                Domain.Heap.Add(Entry);
+                break;
+
+            case EEnhancedTimerEngine::Wheel:
+            {
+                // Overdue deadlines go to the slot processed next; deadlines beyond the span wait in the heap.
+                const int64 Tick = FMath::Max(GetWheelTick(Entry.Deadline), Domain.WheelTick);
+                if (Tick >= Domain.WheelTick + NumWheelSlots)
+                {
+                    Domain.Heap.HeapPush(Entry);
+                }
+                else
+                {
+                    Domain.WheelSlots[(int32)(Tick % NumWheelSlots)].Add(Entry);
+                }
+                break;
+            }
+
+            default:
+                Domain.Heap.HeapPush(Entry);
+                break;
+        }
+    }
+
+    /** Remove every entry with Deadline <= Until and pass it to Func. Returns the number of entries visited. */
+    template<typename FuncType>
+    int32 CollectDue(FEnhancedTimerDomain& Domain, double Until, FuncType&& Func)
+    {
+        int32 NumVisited = 0;
+        switch (Domain.Engine)
+        {
+            case EEnhancedTimerEngine::Scan:
+            {
+                NumVisited = Domain.Heap.Num();
+                for (int32 i = 0; i < Domain.Heap.Num();)
+                {
+                    if (Domain.Heap[i].Deadline <= Until)
+                    {
+                        const FEnhancedTimerHeapEntry Entry = Domain.Heap[i];
+                        Domain.Heap.RemoveAtSwap(i, EAllowShrinking::No);
+                        Func(Entry);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                break;
+            }
+
+            case EEnhancedTimerEngine::Wheel:
+            {
+                // Slots up to the current tick (each at most once), keeping the part of the current slot not due yet.
+                const int64 UntilTick = GetWheelTick(Until);
+                const int64 LastTick  = FMath::Min(UntilTick, Domain.WheelTick + NumWheelSlots - 1);
+                for (int64 Tick = Domain.WheelTick; Tick <= LastTick; ++Tick)
+                {
+                    TArray<FEnhancedTimerHeapEntry>& Slot = Domain.WheelSlots[(int32)(Tick % NumWheelSlots)];
+                    NumVisited += Slot.Num();
+                    for (int32 i = 0; i < Slot.Num();)
+                    {
+                        if (Slot[i].Deadline <= Until)
+                        {
+                            const FEnhancedTimerHeapEntry Entry = Slot[i];
+                            Slot.RemoveAtSwap(i, EAllowShrinking::No);
+                            Func(Entry);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+                Domain.WheelTick = FMath::Max(Domain.WheelTick, UntilTick);
+
+                // Deadlines that moved into the span leave the heap.
+                while (Domain.Heap.Num() > 0 && GetWheelTick(Domain.Heap.HeapTop().Deadline) < Domain.WheelTick + NumWheelSlots)
+                {
+                    FEnhancedTimerHeapEntry Entry;
+                    Domain.Heap.HeapPop(Entry, EAllowShrinking::No);
+                    ++NumVisited;
+                    if (Entry.Deadline <= Until)
+                    {
+                        Func(Entry);
+                    }
+                    else
+                    {
+                        PushEntry(Domain, Entry);
+                    }
+                }
+                break;
+            }
+
+            default:
+            {
+                while (Domain.Heap.Num() > 0 && Domain.Heap.HeapTop().Deadline <= Until)
+                {
+                    FEnhancedTimerHeapEntry Entry;
+                    Domain.Heap.HeapPop(Entry, EAllowShrinking::No);
+                    ++NumVisited;
+                    Func(Entry);
+                }
+                break;
+            }
+        }
+        return NumVisited;
+    }
+
+    /** Visit (without removing) the entries that may have Deadline < Limit; stale entries included. */
+    template<typename FuncType>
+    void ForEachEntryBefore(const FEnhancedTimerDomain& Domain, double Limit, FuncType&& Func) const
+    {
+        if (Domain.Engine == EEnhancedTimerEngine::Scan)
+        {
+            for (const FEnhancedTimerHeapEntry& Entry : Domain.Heap)
+            {
+                if (Entry.Deadline < Limit) Func(Entry);
+            }
+            return;
+        }
+
+        if (Domain.Engine == EEnhancedTimerEngine::Wheel)
+        {
+            const int64 LastTick = FMath::Min(GetWheelTick(Limit), Domain.WheelTick + NumWheelSlots - 1);
+            for (int64 Tick = Domain.WheelTick; Tick <= LastTick; ++Tick)
+            {
+                for (const FEnhancedTimerHeapEntry& Entry : Domain.WheelSlots[(int32)(Tick % NumWheelSlots)])
+                {
+                    if (Entry.Deadline < Limit) Func(Entry);
+                }
+            }
+        }
+
+        // Heap (or the wheel's overflow heap): prune subtrees past the limit.
+        if (Domain.Heap.Num() == 0) return;
+        TArray<int32, TInlineAllocator<64>> Stack;
+        Stack.Add(0);
+        while (Stack.Num() > 0)
+        {
+            const int32 Index = Stack.Pop(EAllowShrinking::No);
+            const FEnhancedTimerHeapEntry& Entry = Domain.Heap[Index];
+            if (Entry.Deadline >= Limit) continue;
+
+            const int32 Left = Index * 2 + 1;
+            if (Left < Domain.Heap.Num())     Stack.Add(Left);
+            if (Left + 1 < Domain.Heap.Num()) Stack.Add(Left + 1);
+            Func(Entry);
+        }
+    }
+
+    /** Lower bound of the earliest pending deadline (MAX_dbl when none). */
+    double GetEarliestDeadline(const FEnhancedTimerDomain& Domain) const
+    {
+        double Min = MAX_dbl;
+        switch (Domain.Engine)
+        {
+            case EEnhancedTimerEngine::Scan:
+                for (const FEnhancedTimerHeapEntry& Entry : Domain.Heap)
+                {
+                    Min = FMath::Min(Min, Entry.Deadline);
+                }
+                break;
+
+            case EEnhancedTimerEngine::Wheel:
+                // Everything in the wheel is before the heap; the first non-empty slot holds the earliest deadline.
+                for (int64 Tick = Domain.WheelTick; Tick < Domain.WheelTick + NumWheelSlots; ++Tick)
+                {
+                    const TArray<FEnhancedTimerHeapEntry>& Slot = Domain.WheelSlots[(int32)(Tick % NumWheelSlots)];
+                    for (const FEnhancedTimerHeapEntry& Entry : Slot)
+                    {
+                        Min = FMath::Min(Min, Entry.Deadline);
+                    }
+                    if (Slot.Num() > 0) return Min;
+                }
+                [[fallthrough]];   // wheel empty: the heap holds the earliest deadline
+
+            default:
+                if (Domain.Heap.Num() > 0)
+                {
+                    Min = FMath::Min(Min, Domain.Heap.HeapTop().Deadline);
+                }
+                break;
+        }
+        return Min;
+    }
+
+    /** Close the workload window when due and switch engines once the same decision was made twice in a row. */
+    void UpdateEngine(FEnhancedTimerDomain& Domain)
+    {
+        EEnhancedTimerEngine Desired = EngineSettings.ForcedEngine;
+        if (EngineSettings.bAdaptive)
+        {
+            const double Window = Domain.Time - Domain.WindowStart;
+            if (Window < EngineSettings.EvaluationPeriod) return;
+
+            FEnhancedTimerWorkload& Workload = Domain.Workload;
+            Workload.NumTimers      = Domain.NumTimers;
+            Workload.ShortFraction  = Domain.WindowScheduled > 0 ? (float)Domain.WindowShort / Domain.WindowScheduled : 0.f;
+            Workload.MeanInterval   = Domain.WindowScheduled > 0 ? (float)(Domain.WindowIntervalSum / Domain.WindowScheduled) : 0.f;
+            Workload.ChurnPerSecond = (float)((Domain.WindowScheduled + Domain.WindowRemoved) / Window);
+
+            Domain.WindowStart       = Domain.Time;
+            Domain.WindowIntervalSum = 0.0;
+            Domain.WindowScheduled   = 0;
+            Domain.WindowShort       = 0;
+            Domain.WindowRemoved     = 0;
+
+            Desired = EngineSettings.Choose(Workload);
+            if (Desired == Domain.Engine)
+            {
+                Domain.CandidateVotes = 0;
+                return;
+            }
+
+            // Hysteresis: a single unusual window does not move the domain.
+            Domain.CandidateVotes = Desired == Domain.Candidate ? Domain.CandidateVotes + 1 : 1;
+            Domain.Candidate      = Desired;
+            if (Domain.CandidateVotes < 2) return;
+            Domain.CandidateVotes = 0;
+        }
+
+        if (Desired == Domain.Engine) return;
+
+        const EEnhancedTimerEngine OldEngine = Domain.Engine;
+        MigrateDomain(Domain, Desired);
+        if (OnEngineSwitched)
+        {
+            OnEngineSwitched(Domain, OldEngine);
+        }
+    }
+
+    /** Move the live deadlines of a domain to another engine. Ids and timers are untouched, so handles stay valid. */
+    void MigrateDomain(FEnhancedTimerDomain& Domain, EEnhancedTimerEngine NewEngine)
+    {
+        MigrationScratch.Reset();
+        auto Keep = [this](const FEnhancedTimerHeapEntry& Entry)
+        {
+            const FTimer* T = Timers.Find(Entry.Id);
+            if (T && T->ScheduleSerial == Entry.Serial)
+            {
+                MigrationScratch.Add(Entry);
+            }
+        };
+        for (const FEnhancedTimerHeapEntry& Entry : Domain.Heap) Keep(Entry);
+        for (const TArray<FEnhancedTimerHeapEntry>& Slot : Domain.WheelSlots)
+        {
+            for (const FEnhancedTimerHeapEntry& Entry : Slot) Keep(Entry);
+        }
+
+        Domain.Heap.Reset();
+        Domain.Engine = NewEngine;
+        if (NewEngine == EEnhancedTimerEngine::Wheel)
+        {
+            Domain.WheelSlots.SetNum(NumWheelSlots);
+            for (TArray<FEnhancedTimerHeapEntry>& Slot : Domain.WheelSlots) Slot.Reset();
+            Domain.WheelTick = GetWheelTick(Domain.Time);
+        }
+        else
+        {
+            Domain.WheelSlots.Empty();
+        }
+
+        for (const FEnhancedTimerHeapEntry& Entry : MigrationScratch)
+        {
+            PushEntry(Domain, Entry);
+        }
+    }
+
+    void SetPaused(FTimer& T, bool bPaused)
+    {
+        if (T.bPaused == bPaused) return;
+
+        if (bPaused)
+        {
+            T.PausedElapsed = GetPhaseElapsed(T);
+            T.bPaused       = true;
+            ++T.ScheduleSerial;    // drop the pending deadline
+        }
+        else
+        {
+            T.PhaseStart = Domains[T.DomainIndex].Time - T.PausedElapsed / T.TimeScale;
+            T.bPaused    = false;
+            Schedule(T);
+        }
+    }
+
+    /** Milestones of one timer (only timers that have some). */
+    struct FMilestoneList
+    {
+        TArray<float> TimesRemaining;    // largest first
+        int32         Next = 0;          // first threshold not crossed in the current period
+    };
+
+    FStorage                                Timers;
+    TMap<uint64, FMilestoneList>            Milestones;
+    TSparseArray<FEnhancedTimerDomain>      Domains;
+    TMap<FEnhancedTimerDomainKey, int32>    DomainLookup;
+    TArray<uint64>                          Transitioned;   // reused by Advance (initial delays ended, milestones crossed)
+    TArray<FEnhancedFiredTimer>             Fired;          // reused by Tick
+    TArray<float>                           Rates;          // reused by Advance
+    TFunction<void(const FTimer&)>          OnRemoved;
+    TFunction<void(const FTimer&, int32)>   OnMilestone;
+    TFunction<void(const FEnhancedTimerDomain&, EEnhancedTimerEngine)> OnEngineSwitched;
+    FEnhancedTimerEngineSettings            EngineSettings;
+    TArray<FEnhancedTimerHeapEntry>         MigrationScratch;
+    uint64                                  NextSequence = 1;
+    bool                                    bTicking = false;
+};
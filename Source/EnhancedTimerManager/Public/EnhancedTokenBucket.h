@@ -0,0 +1,71 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Token bucket refilled lazily from a clock reading: tokens are only computed when the bucket is used, so an idle
+ * bucket costs nothing (no tick, no timer). Any monotonic clock works as long as every call of one bucket uses the
+ * same one; UEnhancedTimerManagerSubsystem reads it from a timer domain clock (see CreateRateLimiter).
+ */
+struct FEnhancedTokenBucket
+{
+	float  Capacity = 1.f;
+	float  RefillPerSecond = 1.f;
+
+	/** (Re)configure the bucket at clock time Now. */
+	void Init(float InCapacity, float InRefillPerSecond, double Now, bool bStartFull = true)
+	{
+		Capacity        = FMath::Max(0.f, InCapacity);
+		RefillPerSecond = FMath::Max(0.f, InRefillPerSecond);
+		Tokens          = bStartFull ? Capacity : 0.f;
+		LastRefill      = Now;
+	}
+
+	/** Take Amount tokens if that many are available. O(1). */
+	bool TryConsume(double Now, float Amount = 1.f)
+	{
+		Refill(Now);
+		if (Tokens + UE_KINDA_SMALL_NUMBER < Amount) return false;
+
+		Tokens = FMath::Max(0.f, Tokens - Amount);
+		return true;
+	}
+
+	float GetTokens(double Now) const
+	{
+		return FMath::Min(Capacity, Tokens + (float)(FMath::Max(0.0, Now - LastRefill) * RefillPerSecond));
+	}
+
+	/** Clock seconds until Amount tokens are available: 0 if they already are, MAX_flt if they never will be. */
+	float GetTimeUntilAvailable(double Now, float Amount = 1.f) const
+	{
+		const float Missing = Amount - GetTokens(Now);
+		if (Missing <= 0.f) return 0.f;
+		if (RefillPerSecond <= 0.f || Amount > Capacity) return MAX_flt;
+		return Missing / RefillPerSecond;
+	}
+
+private:
+	void Refill(double Now)
+	{
+		Tokens     = GetTokens(Now);
+		LastRefill = FMath::Max(LastRefill, Now);
+	}
+
+	float  Tokens = 1.f;
+	double LastRefill = 0.0;
+};
+
+/** Identifies a rate limiter of UEnhancedTimerManagerSubsystem. 0 == Invalid. */
+struct FEnhancedRateLimiterHandle
+{
+	uint64 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Invalidate() { Id = 0; }
+
+	bool operator==(const FEnhancedRateLimiterHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FEnhancedRateLimiterHandle& Other) const { return Id != Other.Id; }
+};
@@ -0,0 +1,24 @@
+// Copyright (C) Thyke. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class EnhancedTimerManagerAI : ModuleRules
+{
+	public EnhancedTimerManagerAI(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"AIModule",
+				"GameplayTasks",
+				"StateTreeModule",
+				"EnhancedTimerManager",
+			}
+			);
+	}
+}
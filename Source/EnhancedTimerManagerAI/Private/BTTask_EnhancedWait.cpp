@@ -0,0 +1,99 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "BTTask_EnhancedWait.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "Engine/GameInstance.h"
+
+UBTTask_EnhancedWait::UBTTask_EnhancedWait(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeName = TEXT("Enhanced Wait");
+	bNotifyTick = false;
+	bNotifyTaskFinished = true;
+}
+
+UEnhancedTimerManagerSubsystem* UBTTask_EnhancedWait::GetTimerSubsystem(const UBehaviorTreeComponent& OwnerComp)
+{
+	const UWorld* World = OwnerComp.GetWorld();
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UEnhancedTimerManagerSubsystem>() : nullptr;
+}
+
+EBTNodeResult::Type UBTTask_EnhancedWait::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	UEnhancedTimerManagerSubsystem* Sub = GetTimerSubsystem(OwnerComp);
+	if (!Sub) return EBTNodeResult::Failed;
+
+	const float Remaining = FMath::Max(0.f, FMath::FRandRange(WaitTime - RandomDeviation, WaitTime + RandomDeviation));
+
+	AActor* DilationActor = nullptr;
+	if (DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation)
+	{
+		const AAIController* AIOwner = OwnerComp.GetAIOwner();
+		DilationActor = AIOwner && AIOwner->GetPawn() ? static_cast<AActor*>(AIOwner->GetPawn()) : OwnerComp.GetOwner();
+	}
+
+	// The node is not instanced: the delegate carries the component, the handle lives in node memory.
+	FBTEnhancedWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory);
+	Memory->Handle = Sub->SetEnhancedTimer(
+		FTimerDelegate::CreateUObject(this, &UBTTask_EnhancedWait::OnWaitFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)),
+		Remaining, DilationMode, DilationActor, bAffectedByGamePause);
+
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_EnhancedWait::OnWaitFinished(TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp)
+{
+	if (UBehaviorTreeComponent* OwnerComp = WeakOwnerComp.Get())
+	{
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
+	}
+}
+
+void UBTTask_EnhancedWait::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	// Covers aborts too: the timer never outlives the task.
+	FBTEnhancedWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory);
+	Memory->Handle.Invalidate();
+	Memory->Handle = FEnhancedTimerHandle();
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+uint16 UBTTask_EnhancedWait::GetInstanceMemorySize() const
+{
+	return sizeof(FBTEnhancedWaitTaskMemory);
+}
+
+void UBTTask_EnhancedWait::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_EnhancedWait::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CastInstanceNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory)->Handle.Invalidate();
+	CleanupNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_EnhancedWait::GetStaticDescription() const
+{
+	const FString Mode = UEnum::GetDisplayValueAsText(DilationMode).ToString();
+	if (FMath::IsNearlyZero(RandomDeviation))
+	{
+		return FString::Printf(TEXT("%s: %.1fs (%s)"), *Super::GetStaticDescription(), WaitTime, *Mode);
+	}
+	return FString::Printf(TEXT("%s: %.1f+-%.1fs (%s)"), *Super::GetStaticDescription(), WaitTime, RandomDeviation, *Mode);
+}
+
+void UBTTask_EnhancedWait::DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const
+{
+	Super::DescribeRuntimeValues(OwnerComp, NodeMemory, Verbosity, Values);
+
+	const FBTEnhancedWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTEnhancedWaitTaskMemory>(NodeMemory);
+	if (Memory->Handle.IsValid())
+	{
+		Values.Add(FString::Printf(TEXT("remaining: %.1fs"), Memory->Handle.GetTimeLeft()));
+	}
+}
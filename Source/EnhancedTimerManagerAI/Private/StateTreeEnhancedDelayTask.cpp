@@ -0,0 +1,41 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "StateTreeEnhancedDelayTask.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "StateTreeExecutionContext.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+FStateTreeEnhancedDelayTask::FStateTreeEnhancedDelayTask()
+{
+	bShouldCallTick = false;
+}
+
+EStateTreeRunStatus FStateTreeEnhancedDelayTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const UWorld* World = Context.GetWorld();
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	UEnhancedTimerManagerSubsystem* Sub = GI ? GI->GetSubsystem<UEnhancedTimerManagerSubsystem>() : nullptr;
+	if (!Sub) return EStateTreeRunStatus::Failed;
+
+	const float Remaining = FMath::Max(0.f, FMath::FRandRange(InstanceData.Duration - InstanceData.RandomDeviation,
+	                                                          InstanceData.Duration + InstanceData.RandomDeviation));
+
+	InstanceData.Handle = Sub->SetEnhancedTimer(
+		FTimerDelegate::CreateLambda([WeakContext = Context.MakeWeakExecutionContext()]()
+		{
+			WeakContext.FinishTask(EStateTreeFinishTaskType::Succeeded);
+		}),
+		Remaining, InstanceData.DilationMode, InstanceData.DilationActor, InstanceData.bAffectedByGamePause);
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeEnhancedDelayTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	InstanceData.Handle.Invalidate();
+	InstanceData.Handle = FEnhancedTimerHandle();
+}
@@ -0,0 +1,59 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "EnhancedTimerHandle.h"
+#include "BTTask_EnhancedWait.generated.h"
+
+class UEnhancedTimerManagerSubsystem;
+
+/**
+ * Wait task backed by an enhanced timer instead of a per-task tick.
+ * ActorTimeDilation follows the controlled pawn's CustomTimeDilation.
+ *
+ * The timers are pooled by the subsystem: each wait takes a slot of its paged timer storage, and finished
+ * waits return the slot for reuse.
+ */
+UCLASS(meta=(DisplayName="Enhanced Wait"))
+class ENHANCEDTIMERMANAGERAI_API UBTTask_EnhancedWait : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_EnhancedWait(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Wait time in seconds. */
+	UPROPERTY(EditAnywhere, Category="Wait", meta=(ClampMin="0.0", UIMin="0.0"))
+	float WaitTime = 5.f;
+
+	/** Allows adding a random value in [-RandomDeviation, RandomDeviation] to WaitTime. */
+	UPROPERTY(EditAnywhere, Category="Wait", meta=(ClampMin="0.0", UIMin="0.0"))
+	float RandomDeviation = 0.f;
+
+	UPROPERTY(EditAnywhere, Category="Wait")
+	EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation;
+
+	/** True keeps the wait running while the game is paused. */
+	UPROPERTY(EditAnywhere, Category="Wait")
+	bool bAffectedByGamePause = false;
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	virtual void DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const override;
+
+private:
+	struct FBTEnhancedWaitTaskMemory
+	{
+		FEnhancedTimerHandle Handle;
+	};
+
+	void OnWaitFinished(TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp);
+
+	static UEnhancedTimerManagerSubsystem* GetTimerSubsystem(const UBehaviorTreeComponent& OwnerComp);
+};
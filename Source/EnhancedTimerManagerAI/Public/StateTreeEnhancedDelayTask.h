@@ -0,0 +1,55 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StateTreeTaskBase.h"
+#include "EnhancedTimerHandle.h"
+#include "StateTreeEnhancedDelayTask.generated.h"
+
+USTRUCT()
+struct ENHANCEDTIMERMANAGERAI_API FStateTreeEnhancedDelayTaskInstanceData
+{
+	GENERATED_BODY()
+
+	/** Delay before the task ends. */
+	UPROPERTY(EditAnywhere, Category="Parameter", meta=(ClampMin="0.0"))
+	float Duration = 1.f;
+
+	/** Adds a random range in [-RandomDeviation, RandomDeviation] to Duration. */
+	UPROPERTY(EditAnywhere, Category="Parameter", meta=(ClampMin="0.0"))
+	float RandomDeviation = 0.f;
+
+	UPROPERTY(EditAnywhere, Category="Parameter")
+	EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::GlobalTimeDilation;
+
+	/** Actor whose CustomTimeDilation is used with ActorTimeDilation (e.g. bind the AI pawn). */
+	UPROPERTY(EditAnywhere, Category="Input", meta=(Optional))
+	TObjectPtr<AActor> DilationActor = nullptr;
+
+	/** True keeps the delay running while the game is paused. */
+	UPROPERTY(EditAnywhere, Category="Parameter")
+	bool bAffectedByGamePause = false;
+
+	/** Timer of the active state. */
+	FEnhancedTimerHandle Handle;
+};
+
+/**
+ * Delay task backed by an enhanced timer. It does not tick: the timer finishes the task
+ * (Succeeded) through a weak execution context. Like the BT wait, it takes a recycled slot of the
+ * subsystem's timer storage.
+ */
+USTRUCT(meta=(DisplayName="Enhanced Delay Task", Category="Common"))
+struct ENHANCEDTIMERMANAGERAI_API FStateTreeEnhancedDelayTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	using FInstanceDataType = FStateTreeEnhancedDelayTaskInstanceData;
+
+	FStateTreeEnhancedDelayTask();
+
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+};
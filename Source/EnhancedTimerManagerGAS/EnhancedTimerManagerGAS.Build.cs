@@ -0,0 +1,24 @@
+// Copyright (C) Thyke. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class EnhancedTimerManagerGAS : ModuleRules
+{
+	public EnhancedTimerManagerGAS(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"GameplayAbilities",
+				"GameplayTags",
+				"GameplayTasks",
+				"EnhancedTimerManager",
+			}
+			);
+	}
+}
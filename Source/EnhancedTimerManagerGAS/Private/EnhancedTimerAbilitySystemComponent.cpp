@@ -0,0 +1,277 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerAbilitySystemComponent.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "GameplayEffect.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void UEnhancedTimerAbilitySystemComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// GAS only times durations and periods on the authority.
+	if (!bUseEnhancedTimers || !IsOwnerActorAuthoritative()) return;
+
+	OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &UEnhancedTimerAbilitySystemComponent::OnEffectAdded);
+	OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &UEnhancedTimerAbilitySystemComponent::OnEffectRemoved);
+}
+
+void UEnhancedTimerAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OnActiveGameplayEffectAddedDelegateToSelf.RemoveAll(this);
+	OnAnyGameplayEffectRemovedDelegate().RemoveAll(this);
+
+	BatchTimer.Invalidate();
+	TakeoverTimer.Invalidate();
+	Effects.Reset();
+	Deadlines.Reset();
+	PendingTakeovers.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UEnhancedTimerManagerSubsystem* UEnhancedTimerAbilitySystemComponent::GetTimerSubsystem() const
+{
+	const UWorld* World = GetWorld();
+	const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UEnhancedTimerManagerSubsystem>() : nullptr;
+}
+
+double UEnhancedTimerAbilitySystemComponent::GetClockTime() const
+{
+	// Between re-arms the clock is the batch timer's own (dilated) elapsed time.
+	const float Elapsed = BatchTimer.IsValid() ? BatchTimer.GetElapsedTime() : 0.f;
+	return ClockBase + FMath::Max(0.f, Elapsed);
+}
+
+// ===== Effect notifications =====
+
+void UEnhancedTimerAbilitySystemComponent::OnEffectAdded(UAbilitySystemComponent* /*Target*/, const FGameplayEffectSpec& /*Spec*/, FActiveGameplayEffectHandle Handle)
+{
+	if (!Effects.Contains(Handle))
+	{
+		if (FOnActiveGameplayEffectTimeChange* TimeChanged = OnGameplayEffectTimeChangeDelegate(Handle))
+		{
+			TimeChanged->AddUObject(this, &UEnhancedTimerAbilitySystemComponent::OnEffectTimeChanged);
+		}
+		if (FOnActiveGameplayEffectStackChange* StackChanged = OnGameplayEffectStackChangeDelegate(Handle))
+		{
+			StackChanged->AddUObject(this, &UEnhancedTimerAbilitySystemComponent::OnEffectStackChanged);
+		}
+	}
+	// The container armed the engine timers before notifying; clear them before they can tick.
+	if (TakeOver(Handle))
+	{
+		RearmBatchTimer();
+	}
+}
+
+void UEnhancedTimerAbilitySystemComponent::OnEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	// Heap entries of the effect become stale and are skipped when they surface.
+	Effects.Remove(Effect.Handle);
+}
+
+void UEnhancedTimerAbilitySystemComponent::OnEffectTimeChanged(FActiveGameplayEffectHandle Handle, float /*NewStartTime*/, float /*NewDuration*/)
+{
+	// GAS re-armed its own duration timer before notifying; take it over again.
+	if (TakeOver(Handle))
+	{
+		RearmBatchTimer();
+	}
+}
+
+void UEnhancedTimerAbilitySystemComponent::OnEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 /*NewStackCount*/, int32 /*PreviousStackCount*/)
+{
+	// Stacking refreshes the duration or resets the period after this notification.
+	RequestTakeover(Handle);
+}
+
+// ===== Takeover =====
+
+bool UEnhancedTimerAbilitySystemComponent::TakeOver(FActiveGameplayEffectHandle Handle)
+{
+	const UWorld* World = GetWorld();
+	FActiveGameplayEffect* Effect = World ? ActiveGameplayEffects.GetActiveGameplayEffect(Handle) : nullptr;
+	if (!Effect) return false;
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	const bool bDuration = TimerManager.IsTimerActive(Effect->DurationHandle);
+	const bool bPeriod   = TimerManager.IsTimerActive(Effect->PeriodHandle);
+	if (!bDuration && !bPeriod) return false;
+
+	FEffectTimes& Times = Effects.FindOrAdd(Handle);
+	const double Now = GetClockTime();
+
+	// Remaining engine time becomes a delay on the component clock, from now on subject to DilationMode.
+	if (bDuration)
+	{
+		const float Remaining = FMath::Max(0.f, TimerManager.GetTimerRemaining(Effect->DurationHandle));
+		TimerManager.ClearTimer(Effect->DurationHandle);
+		Times.DurationDeadline = Now + Remaining;
+		PushDeadline(Times.DurationDeadline, Handle, false);
+	}
+
+	if (bPeriod)
+	{
+		const float Remaining = FMath::Max(0.f, TimerManager.GetTimerRemaining(Effect->PeriodHandle));
+		TimerManager.ClearTimer(Effect->PeriodHandle);
+		Times.Period         = Effect->GetPeriod();
+		Times.PeriodDeadline = Now + Remaining;
+		PushDeadline(Times.PeriodDeadline, Handle, true);
+	}
+	return true;
+}
+
+void UEnhancedTimerAbilitySystemComponent::RequestTakeover(FActiveGameplayEffectHandle Handle)
+{
+	PendingTakeovers.AddUnique(Handle);
+	if (TakeoverTimer.IsValid()) return;
+
+	if (UEnhancedTimerManagerSubsystem* Sub = GetTimerSubsystem())
+	{
+		TakeoverTimer = Sub->SetEnhancedTimerExecutedInNextTick(
+			FTimerDelegate::CreateUObject(this, &UEnhancedTimerAbilitySystemComponent::ProcessTakeovers));
+	}
+}
+
+void UEnhancedTimerAbilitySystemComponent::ProcessTakeovers()
+{
+	TakeoverTimer = FEnhancedTimerHandle();
+
+	for (const FActiveGameplayEffectHandle& Handle : PendingTakeovers)
+	{
+		TakeOver(Handle);
+	}
+	PendingTakeovers.Reset();
+
+	RearmBatchTimer();
+}
+
+// ===== Deadline heap =====
+
+void UEnhancedTimerAbilitySystemComponent::PushDeadline(double Time, FActiveGameplayEffectHandle Handle, bool bPeriod)
+{
+	Deadlines.HeapPush({ Time, Handle, bPeriod });
+}
+
+bool UEnhancedTimerAbilitySystemComponent::IsStale(const FDeadline& Deadline) const
+{
+	const FEffectTimes* Times = Effects.Find(Deadline.Handle);
+	if (!Times) return true;
+	return (Deadline.bPeriod ? Times->PeriodDeadline : Times->DurationDeadline) != Deadline.Time;
+}
+
+void UEnhancedTimerAbilitySystemComponent::RearmBatchTimer()
+{
+	if (bInBatch) return;
+
+	while (Deadlines.Num() > 0 && IsStale(Deadlines.HeapTop()))
+	{
+		Deadlines.HeapPopDiscard();
+	}
+
+	const double Now = GetClockTime();
+	if (Deadlines.Num() == 0)
+	{
+		BatchTimer.Invalidate();
+		BatchTimer    = FEnhancedTimerHandle();
+		ClockBase     = Now;
+		ArmedDeadline = -1.0;
+		return;
+	}
+
+	const double Next = Deadlines.HeapTop().Time;
+	if (BatchTimer.IsValid() && Next == ArmedDeadline) return;
+
+	UEnhancedTimerManagerSubsystem* Sub = GetTimerSubsystem();
+	if (!Sub) return;
+
+	BatchTimer.Invalidate();
+	ClockBase     = Now;
+	ArmedDeadline = Next;
+
+	AActor* DilationActor = DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation ? GetAvatarActor_Direct() : nullptr;
+	BatchTimer = Sub->SetEnhancedTimer(FTimerDelegate::CreateUObject(this, &UEnhancedTimerAbilitySystemComponent::OnBatchTimer),
+	                                   (float)FMath::Max(0.0, Next - Now), DilationMode, DilationActor, bAffectedByGamePause);
+}
+
+void UEnhancedTimerAbilitySystemComponent::OnBatchTimer()
+{
+	// The timer reached ArmedDeadline; continue the clock from there.
+	BatchTimer    = FEnhancedTimerHandle();
+	ClockBase     = FMath::Max(ClockBase, ArmedDeadline);
+	ArmedDeadline = -1.0;
+
+	const double Now = ClockBase;
+
+	DueScratch.Reset();
+	while (Deadlines.Num() > 0 && Deadlines.HeapTop().Time <= Now + UE_KINDA_SMALL_NUMBER)
+	{
+		FDeadline Deadline;
+		Deadlines.HeapPop(Deadline);
+		if (!IsStale(Deadline))
+		{
+			DueScratch.Add(Deadline);
+		}
+	}
+
+	{
+		TGuardValue<bool> BatchGuard(bInBatch, true);
+
+		for (const FDeadline& Deadline : DueScratch)
+		{
+			// An earlier entry of this batch may have removed or rescheduled the effect.
+			if (IsStale(Deadline)) continue;
+
+			if (Deadline.bPeriod)
+			{
+				FEffectTimes& Times = Effects.FindChecked(Deadline.Handle);
+				Times.PeriodDeadline = Times.Period > 0.f ? Deadline.Time + Times.Period : -1.0;
+				if (Times.PeriodDeadline >= 0.0)
+				{
+					PushDeadline(Times.PeriodDeadline, Deadline.Handle, true);
+				}
+				ActiveGameplayEffects.ExecutePeriodicGameplayEffect(Deadline.Handle);
+			}
+			else
+			{
+				Effects.FindChecked(Deadline.Handle).DurationDeadline = -1.0;
+				ExpireEffect(Deadline.Handle);
+			}
+		}
+	}
+	DueScratch.Reset();
+
+	RearmBatchTimer();
+}
+
+void UEnhancedTimerAbilitySystemComponent::ExpireEffect(FActiveGameplayEffectHandle Handle)
+{
+	const FActiveGameplayEffect* Effect = ActiveGameplayEffects.GetActiveGameplayEffect(Handle);
+	if (!Effect || !Effect->Spec.Def)
+	{
+		Effects.Remove(Handle);
+		return;
+	}
+
+	const EGameplayEffectStackingExpirationPolicy Policy = Effect->Spec.Def->StackExpirationPolicy;
+	const bool bRemoveAll = Policy == EGameplayEffectStackingExpirationPolicy::ClearEntireStack || Effect->Spec.GetStackCount() <= 1;
+
+	if (Policy != EGameplayEffectStackingExpirationPolicy::RefreshDuration)
+	{
+		RemoveActiveGameplayEffect(Handle, bRemoveAll ? -1 : 1);
+		if (bRemoveAll) return;
+	}
+
+	// Refresh: restart the GAS start time; the time-change notification hands the new duration back to us.
+	if (const UWorld* World = GetWorld())
+	{
+		if (const FActiveGameplayEffect* Remaining = ActiveGameplayEffects.GetActiveGameplayEffect(Handle))
+		{
+			ActiveGameplayEffects.ModifyActiveEffectStartTime(Handle, World->GetTimeSeconds() - Remaining->StartWorldTime);
+		}
+	}
+}
@@ -0,0 +1,106 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "EnhancedTimerHandle.h"
+#include "EnhancedTimerAbilitySystemComponent.generated.h"
+
+/**
+ * Ability system component that runs gameplay effect durations and periods on the enhanced timer engine.
+ *
+ * On the authority, the engine FTimerManager timers GAS creates for every active effect (DurationHandle /
+ * PeriodHandle) are taken over: their remaining time moves into a per-component deadline heap and the engine
+ * timers are cleared. A single enhanced timer per component is armed for the earliest deadline; when it fires,
+ * every due effect is expired or executed in one batch.
+ *
+ * GAS arms the engine timers inside FActiveGameplayEffectsContainer, which has no override point for it in 5.6,
+ * so they are still created; the takeover only decides who runs them. It happens inside the add / time-change
+ * notification, before any engine timer can tick. Stacking re-arms the timers after its notification, so
+ * stack changes are taken over with the next tick.
+ *
+ * Deadlines advance with DilationMode (ActorTimeDilation follows the avatar actor). Stack expiration
+ * policies are applied as GAS does: clear the stack, remove a single stack and refresh, or refresh.
+ */
+UCLASS(ClassGroup=AbilitySystem, meta=(BlueprintSpawnableComponent))
+class ENHANCEDTIMERMANAGERGAS_API UEnhancedTimerAbilitySystemComponent : public UAbilitySystemComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Disable to keep the stock FTimerManager backend for this component. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EnhancedTimers")
+	bool bUseEnhancedTimers = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EnhancedTimers")
+	EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::ActorTimeDilation;
+
+	/** True keeps effect durations running while the game is paused. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="EnhancedTimers")
+	bool bAffectedByGamePause = false;
+
+	/** Number of effects whose duration or period is currently driven by enhanced timers. */
+	int32 GetNumScheduledEffects() const { return Effects.Num(); }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Deadlines of one effect on the component clock; < 0 = not scheduled. */
+	struct FEffectTimes
+	{
+		double DurationDeadline = -1.0;
+		double PeriodDeadline = -1.0;
+		float  Period = 0.f;
+	};
+
+	/** Heap entry; stale once it no longer matches FEffectTimes (lazy deletion). */
+	struct FDeadline
+	{
+		double                       Time = 0.0;
+		FActiveGameplayEffectHandle  Handle;
+		bool                         bPeriod = false;
+
+		bool operator<(const FDeadline& Other) const
+		{
+			// Periods first on ties, so a final period tick runs before the effect expires.
+			return Time != Other.Time ? Time < Other.Time : (bPeriod && !Other.bPeriod);
+		}
+	};
+
+	void OnEffectAdded(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void OnEffectRemoved(const FActiveGameplayEffect& Effect);
+	void OnEffectTimeChanged(FActiveGameplayEffectHandle Handle, float NewStartTime, float NewDuration);
+	void OnEffectStackChanged(FActiveGameplayEffectHandle Handle, int32 NewStackCount, int32 PreviousStackCount);
+
+	/** Take over the effect's engine timers that are running now; false if none was. */
+	bool TakeOver(FActiveGameplayEffectHandle Handle);
+
+	/** Queue a takeover of the effect's engine timers for the next frame (one batch per component). */
+	void RequestTakeover(FActiveGameplayEffectHandle Handle);
+	void ProcessTakeovers();
+	void OnBatchTimer();
+
+	bool IsStale(const FDeadline& Deadline) const;
+	void PushDeadline(double Time, FActiveGameplayEffectHandle Handle, bool bPeriod);
+	void ExpireEffect(FActiveGameplayEffectHandle Handle);
+	void RearmBatchTimer();
+
+	/** Component clock: timer seconds elapsed under DilationMode. */
+	double GetClockTime() const;
+
+	class UEnhancedTimerManagerSubsystem* GetTimerSubsystem() const;
+
+	TMap<FActiveGameplayEffectHandle, FEffectTimes> Effects;
+	TArray<FDeadline>                               Deadlines;          // min-heap
+	TArray<FActiveGameplayEffectHandle>             PendingTakeovers;
+	TArray<FDeadline>                               DueScratch;
+
+	FEnhancedTimerHandle  BatchTimer;
+	FEnhancedTimerHandle  TakeoverTimer;
+	double                ClockBase = 0.0;       // clock time when BatchTimer was armed
+	double                ArmedDeadline = -1.0;
+	bool                  bInBatch = false;
+};
@@ -0,0 +1,29 @@
+// Copyright (C) Thyke. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class EnhancedTimerManagerMass : ModuleRules
+{
+	public EnhancedTimerManagerMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"MassEntity",
+				"EnhancedTimerManager",
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"MassSignals",
+			}
+			);
+	}
+}
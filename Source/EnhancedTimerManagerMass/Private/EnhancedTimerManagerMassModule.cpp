@@ -0,0 +1,5 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, EnhancedTimerManagerMass)
@@ -0,0 +1,97 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#include "EnhancedTimerMassProcessor.h"
+#include "EnhancedTimerMassTypes.h"
+#include "EnhancedTimerManagerSubsystem.h"
+#include "MassCommandBuffer.h"
+#include "MassExecutionContext.h"
+#include "MassSignalSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+
+UEnhancedTimerMassProcessor::UEnhancedTimerMassProcessor()
+	: EntityQuery(*this)
+{
+	ExpiredSignal = UE::EnhancedTimer::Mass::Signals::TimerExpired;
+	bAutoRegisterWithProcessingPhases = true;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionFlags = (int32)EProcessorExecutionFlags::AllNetModes;
+}
+
+void UEnhancedTimerMassProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FEnhancedTimerFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FEnhancedTimerDilationActorFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddSubsystemRequirement<UMassSignalSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+void UEnhancedTimerMassProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UWorld* World = EntityManager.GetWorld();
+	const float DeltaTime  = Context.GetDeltaTimeSeconds();
+	const bool  bPausedNow = World ? UGameplayStatics::IsGamePaused(World) : false;
+
+	// Mode scales that do not depend on the entity, resolved once per frame.
+	const float IgnoreScale = EnhancedTimers::GetDilationScale(EEnhancedTimerTimeDilationMode::IgnoreTimeDilation, World, nullptr);
+	const float GlobalScale = EnhancedTimers::GetDilationScale(EEnhancedTimerTimeDilationMode::GlobalTimeDilation, World, nullptr);
+
+	ExpiredEntities.Reset();
+
+	EntityQuery.ForEachEntityChunk(Context, [&](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FEnhancedTimerFragment> TimerList = ChunkContext.GetMutableFragmentView<FEnhancedTimerFragment>();
+		const TConstArrayView<FEnhancedTimerDilationActorFragment> ActorList = ChunkContext.GetFragmentView<FEnhancedTimerDilationActorFragment>();
+		const bool bHasActors = ActorList.Num() > 0;
+
+		const int32 NumEntities = ChunkContext.GetNumEntities();
+		for (int32 i = 0; i < NumEntities; ++i)
+		{
+			FEnhancedTimerFragment& Timer = TimerList[i];
+			if (!Timer.bActive || Timer.bPaused) continue;
+			if (bPausedNow && !Timer.bAffectedByGamePause) continue;
+
+			float Scale = IgnoreScale;
+			if (Timer.DilationMode == EEnhancedTimerTimeDilationMode::GlobalTimeDilation)
+			{
+				Scale = GlobalScale;
+			}
+			else if (Timer.DilationMode == EEnhancedTimerTimeDilationMode::ActorTimeDilation)
+			{
+				Scale = EnhancedTimers::GetDilationScale(Timer.DilationMode, World, bHasActors ? ActorList[i].Actor.Get() : nullptr);
+			}
+
+			Timer.Remaining -= DeltaTime * Scale;
+			if (Timer.Remaining > KINDA_SMALL_NUMBER) continue;
+
+			ExpiredEntities.Add(ChunkContext.GetEntity(i));
+			if (Timer.Period > 0.f)
+			{
+				// Keep the overshoot so looping entities do not drift; never catch up more than one period.
+				Timer.Remaining = FMath::Max(Timer.Remaining + Timer.Period, 0.f);
+			}
+			else
+			{
+				Timer.Remaining = 0.f;
+				Timer.bActive   = false;
+			}
+		}
+	});
+
+	if (ExpiredEntities.Num() == 0) return;
+
+	if (!ExpiredSignal.IsNone())
+	{
+		if (UMassSignalSubsystem* SignalSubsystem = Context.GetMutableSubsystem<UMassSignalSubsystem>())
+		{
+			SignalSubsystem->SignalEntities(ExpiredSignal, ExpiredEntities);
+		}
+	}
+
+	if (bAddExpiredTag)
+	{
+		// Same-type commands are grouped by the command buffer and flushed as one batch.
+		for (const FMassEntityHandle& Entity : ExpiredEntities)
+		{
+			Context.Defer().AddTag<FEnhancedTimerExpiredTag>(Entity);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "EnhancedTimerMassProcessor.generated.h"
+
+/**
+ * Advances FEnhancedTimerFragment chunk by chunk. Dilation scales are resolved once per frame
+ * (per entity only for ActorTimeDilation) and expired entities are reported in bulk:
+ * one SignalEntities call and/or a batched FEnhancedTimerExpiredTag add per frame.
+ */
+UCLASS()
+class ENHANCEDTIMERMANAGERMASS_API UEnhancedTimerMassProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UEnhancedTimerMassProcessor();
+
+	/** Signal raised for expired entities; None disables signalling. */
+	UPROPERTY(EditAnywhere, Config, Category="EnhancedTimers")
+	FName ExpiredSignal;
+
+	/** Add FEnhancedTimerExpiredTag to expired entities. */
+	UPROPERTY(EditAnywhere, Config, Category="EnhancedTimers")
+	bool bAddExpiredTag = true;
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+
+	/** Reused across frames to avoid per-frame allocations. */
+	TArray<FMassEntityHandle> ExpiredEntities;
+};
@@ -0,0 +1,78 @@
+﻿// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "EnhancedTimerManagerTypes.h"
+#include "EnhancedTimerMassTypes.generated.h"
+
+namespace UE::EnhancedTimer::Mass::Signals
+{
+	/** Default signal raised (in bulk) for entities whose timer expired this frame. */
+	const FName TimerExpired = FName(TEXT("EnhancedTimerExpired"));
+}
+
+/**
+ * Compact per-entity timer (12 bytes, no delegates). Advanced chunk by chunk by UEnhancedTimerMassProcessor
+ * with the same dilation and pause semantics as UEnhancedTimerManagerSubsystem.
+ */
+USTRUCT()
+struct ENHANCEDTIMERMANAGERMASS_API FEnhancedTimerFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Timer seconds left in the current period. */
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	float Remaining = 0.f;
+
+	/** Re-arm period for looping timers; 0 = one-shot. */
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	float Period = 0.f;
+
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	EEnhancedTimerTimeDilationMode DilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation;
+
+	/** Counting down (cleared when a one-shot expires). */
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	bool bActive = false;
+
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	bool bPaused = false;
+
+	/** Same meaning as on subsystem timers: true keeps the timer running while the game is paused. */
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	bool bAffectedByGamePause = false;
+
+	/** (Re)start the timer. */
+	void Start(float Duration, bool bLoop = false,
+	           EEnhancedTimerTimeDilationMode InDilationMode = EEnhancedTimerTimeDilationMode::IgnoreTimeDilation,
+	           bool bInAffectedByGamePause = false)
+	{
+		Remaining            = FMath::Max(0.f, Duration);
+		Period               = bLoop ? FMath::Max(0.f, Duration) : 0.f;
+		DilationMode         = InDilationMode;
+		bActive              = true;
+		bPaused              = false;
+		bAffectedByGamePause = bInAffectedByGamePause;
+	}
+
+	void Stop() { bActive = false; }
+};
+
+/** Optional: actor whose CustomTimeDilation drives entities using ActorTimeDilation. */
+USTRUCT()
+struct ENHANCEDTIMERMANAGERMASS_API FEnhancedTimerDilationActorFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="EnhancedTimers")
+	TWeakObjectPtr<AActor> Actor;
+};
+
+/** Added (in bulk, through the deferred command buffer) to entities whose timer expired. Remove it once handled. */
+USTRUCT()
+struct ENHANCEDTIMERMANAGERMASS_API FEnhancedTimerExpiredTag : public FMassTag
+{
+	GENERATED_BODY()
+};